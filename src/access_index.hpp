@@ -0,0 +1,134 @@
+#pragma once
+
+#include "transition_record.hpp"
+
+#include "execution.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file access_index.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Indexes the Transitions of a prefix of an execution by the operand they access, such that
+/// the Transitions on which a new instruction depends through its operand are found without
+/// scanning the prefix.
+/// @details Following Dependence, an access is exclusive if it is dependent with every access to
+/// the same operand and two non-exclusive accesses to the same operand are independent. For each
+/// operand, the index holds the last exclusive access and, for each thread, the last
+/// non-exclusive access since. All other accesses to the operand happen-before one of these.
+
+template <typename Dependence>
+class access_index
+{
+public:
+   using execution_t = program_model::Execution;
+   using index_t = execution_t::index_t;
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @brief Returns the number of indexed Transitions, i.e. this access_index is defined on
+   /// pre(E, size()+1).
+
+   index_t size() const
+   {
+      return mUndo.size();
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @brief Adds the access of record, which is decoded from E[size()+1].instr().
+
+   void push_back(const transition_record& record)
+   {
+      const auto operand = record.operand;
+      const index_t index = size() + 1;
+      if (mEntries.size() <= operand)
+         mEntries.resize(operand + 1);
+      entry& accesses = mEntries[operand];
+      mUndo.emplace_back(operand, accesses);
+      if (Dependence::exclusive(record))
+      {
+         accesses.exclusive = index;
+         accesses.shared.clear();
+      }
+      else
+      {
+         const auto tid = record.tid;
+         auto it = std::find_if(accesses.shared.begin(), accesses.shared.end(),
+                                [&tid](const auto& access) { return access.first == tid; });
+         if (it != accesses.shared.end())
+            it->second = index;
+         else
+            accesses.shared.emplace_back(tid, index);
+      }
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @brief Removes the access of the last indexed Transition.
+
+   void pop_back()
+   {
+      /// @pre size() > 0
+      assert(size() > 0);
+      auto& undo = mUndo.back();
+      mEntries[undo.first] = std::move(undo.second);
+      mUndo.pop_back();
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @brief Calls f(j) for the indexed accesses j to record's operand that are dependent
+   /// with record and do not happen-before another such access.
+   /// @note Dependencies through program order are not considered.
+
+   template <typename Function>
+   void for_each_dependent(const transition_record& record, Function f) const
+   {
+      if (record.operand >= mEntries.size())
+         return;
+      const entry& accesses = mEntries[record.operand];
+      if (accesses.exclusive > 0)
+         f(accesses.exclusive);
+      if (Dependence::exclusive(record))
+      {
+         for (const auto& access : accesses.shared)
+            f(access.second);
+      }
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+private:
+
+   using tid_t = program_model::Thread::tid_t;
+   using operand_t = operand_interner::id_t;
+
+   struct entry
+   {
+      index_t exclusive = 0;
+      std::vector<std::pair<tid_t, index_t>> shared;
+   };
+
+   /// @brief The accesses per operand, indexed by the operand's id.
+   std::vector<entry> mEntries;
+
+   /// @brief For each indexed Transition, the entry of its operand before it was indexed.
+   std::vector<std::pair<operand_t, entry>> mUndo;
+
+}; // end class template access_index<Dependence>
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
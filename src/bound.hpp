@@ -1,6 +1,7 @@
 #pragma once
 
 // SCHEDULER
+#include "schedule.hpp"
 #include "scheduler_settings.hpp"
 
 // PROGRAM_MODEL
@@ -9,6 +10,11 @@
 #include "state.hpp"
 #include "visible_instruction_io.hpp"
 
+// EXPLORATION
+#include "tid_set.hpp"
+
+#include <boost/optional.hpp>
+
 // UTILS
 #include "debug.hpp"
 #include "container_output.hpp"
@@ -59,6 +65,8 @@ public:
    explicit bound(const execution_t& execution, const typename bound_function_t::value_t bound_value)
    : mState({ BoundState() })
    , mBoundValue(bound_value) 
+   , mPrunedFloor(boost::none)
+   , mPruned()
    { 
    }
    
@@ -80,9 +88,6 @@ public:
         
    /// @brief Does nothing.
    inline void update_statistics(const execution_t&) { }
-        
-   /// @brief Does nothing.
-   inline void restore_state(const transition_t&) { }
    
    //-----------------------------------------------------------------------------------------------
 
@@ -100,6 +105,37 @@ public:
       mState.emplace_back(bound_function_t::value(execution, mState, transition.index()-1, tid));
       DEBUGF(outputname(), "update_state", transition.instr(), to_string_post_state(transition) 
              << ".bound_value = " << mState.back().bound_value() << "\n");
+      if (mPrunedFloor)
+      {
+         if (transition.index() == 1 && *mPrunedFloor == 0)
+         {
+            add_pruned(execution, 0);
+         }
+         if (transition.index() >= *mPrunedFloor)
+         {
+            add_pruned(execution, transition.index());
+         }
+      }
+   }
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Starts recording the branches that pool prunes, i.e. the schedules 
+   /// prefix(execution, index).tid with tid enabled and bound_function_t::value > mBoundValue, at 
+   /// the states with index >= floor. As update_state is only called on new Transitions, every 
+   /// pruned branch is recorded once.
+   /// @note If bound_function_t is monotonic and increases by at most one per step, the pruned 
+   /// branches are exactly the roots of the subtrees that a bound of mBoundValue+1 adds.
+   
+   void record_pruned(const std::size_t floor) { mPrunedFloor = floor; }
+   
+   /// @brief Returns and clears the pruned branches recorded since the last call.
+   
+   std::vector<scheduler::schedule_t> take_pruned()
+   {
+      std::vector<scheduler::schedule_t> pruned{};
+      pruned.swap(mPruned);
+      return pruned;
    }
    
    //-----------------------------------------------------------------------------------------------
@@ -107,19 +143,36 @@ public:
    /// @brief Does nothing.
    inline void update_after_exploration(transition_t& transition) { }
    
+   /// @brief Does nothing.
+   inline void extend_schedule(const execution_t&, scheduler::schedule_t&) { }
+   
    //-----------------------------------------------------------------------------------------------
         
    /// @note Returns a subset of execution.final().enabled.
    
-   program_model::Tids pool(const execution_t& execution)
+   tid_set pool(const execution_t& execution)
    {
-      program_model::Tids pool;
-      std::copy_if(execution.final().enabled().begin(), execution.final().enabled().end(),
-                   std::inserter(pool, pool.end()),
-                   [this, &execution] (const auto& tid) 
-                   {
-                     return bound_function_t::value(execution, mState, execution.size(), tid) <= mBoundValue;
-                   });
+      return pool(execution, execution.size());
+   }
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Returns the pool of the index'th state of the execution (i.e. pre+(execution,index)).
+   /// @note Returns a subset of the enabled set of that state.
+   
+   tid_set pool(const execution_t& execution, const std::size_t index)
+   {
+      /// @pre index <= execution.size()
+      assert(index <= execution.size());
+      const auto& state = index < execution.size() ? execution[index+1].pre() : execution.final();
+      tid_set pool;
+      for (const auto& tid : state.enabled())
+      {
+         if (bound_function_t::value(execution, mState, index, tid) <= mBoundValue)
+         {
+            pool.insert(tid);
+         }
+      }
       return pool;
    }
    
@@ -128,7 +181,7 @@ public:
    /// @brief Returns the first tid in the pool.
    
    static program_model::Thread::tid_t select_from_pool(const execution_t& execution, 
-                                                        const program_model::Tids& pool)
+                                                        const tid_set& pool)
    {
       /// @pre !pool.empty()
       assert(!pool.empty());
@@ -139,6 +192,11 @@ public:
    //-----------------------------------------------------------------------------------------------
         
    void pop_back();
+   
+   /// @brief Do nothing, as the BoundStates are determined by the branch that is replayed on 
+   /// resuming.
+   inline void save(std::ostream&) const { }
+   inline void restore(std::istream&) { }
         
    /// @brief Does nothing.
    inline void close(const std::string& statistics) const { }
@@ -150,9 +208,38 @@ public:
 private:
    
    static std::string outputname();
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Adds { prefix(execution, index).tid | tid in pre+(execution, index).enabled() with
+   /// bound_function_t::value > mBoundValue } to mPruned.
+   
+   void add_pruned(const execution_t& execution, const std::size_t index)
+   {
+      const auto& state = index < execution.size() ? execution[index+1].pre() : execution.final();
+      scheduler::schedule_t prefix{};
+      for (const auto& tid : state.enabled())
+      {
+         if (bound_function_t::value(execution, mState, index, tid) > mBoundValue)
+         {
+            if (prefix.empty())
+            {
+               for (std::size_t i = 1; i <= index; ++i)
+               {
+                  prefix.push_back(
+                     boost::apply_visitor(program_model::get_tid(), execution[i].instr()));
+               }
+            }
+            mPruned.push_back(prefix);
+            mPruned.back().push_back(tid);
+         }
+      }
+   }
         
    std::vector<BoundState> mState;
    int mBoundValue;
+   boost::optional<std::size_t> mPrunedFloor;
+   std::vector<scheduler::schedule_t> mPruned;
         
 }; // end class template bound<bound_function_t>
 
@@ -43,7 +43,7 @@ namespace bound_functions
         template<typename Sequence>
         static value_t value(
             const Execution& E,
-            const Sequence S,
+            const Sequence& S,
             const unsigned int index,
             const Thread::tid_t& tid)
         {
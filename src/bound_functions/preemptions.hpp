@@ -3,6 +3,7 @@
 #define PREEMPTIONS_HPP_INCLUDED
 
 #include "local_bound_function.hpp"
+#include "tid_set.hpp"
 
 /*---------------------------------------------------------------------------75*/
 /**
@@ -48,11 +49,11 @@ namespace bound_functions
          there may be instance-specific optimizations for selecting the
          element with minimal value.
          */
-        static Tids::const_iterator min_value(
+        static exploration::tid_set::const_iterator min_value(
             const Execution& E,
             const index_t index,
-            const Tids& T,
-            const Tids& Prioritize={})
+            const exploration::tid_set& T,
+            const exploration::tid_set& Prioritize={})
         {
             /// @pre !T.empty()
             assert(!T.empty());
@@ -0,0 +1,120 @@
+#pragma once
+
+// SCHEDULER
+#include "schedule.hpp"
+
+// EXPLORATION
+#include "sufficient_sets/sleep_set.hpp"
+#include "tid_set.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file checkpoint.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+namespace checkpoint {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Binary (de)serialization of the parts of the state of an Exploration that the replay of
+/// the current branch does not reproduce (see Exploration::resume). Values are written in the
+/// byte order of the host, as a checkpoint is only read back by the explorer that wrote it.
+
+template <typename T>
+void write(std::ostream& os, const T value)
+{
+   static_assert(std::is_trivially_copyable<T>::value, "write requires a trivial type");
+   os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+/// @throws std::runtime_error if is ends before a complete value was read.
+
+template <typename T>
+T read(std::istream& is)
+{
+   static_assert(std::is_trivially_copyable<T>::value, "read requires a trivial type");
+   T value;
+   if (!is.read(reinterpret_cast<char*>(&value), sizeof(T)))
+      throw std::runtime_error("Truncated checkpoint");
+   return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+inline void write_string(std::ostream& os, const std::string& string)
+{
+   write<std::uint64_t>(os, string.size());
+   os.write(string.data(), string.size());
+}
+
+inline std::string read_string(std::istream& is)
+{
+   std::string string(read<std::uint64_t>(is), '\0');
+   if (!is.read(&string[0], string.size()))
+      throw std::runtime_error("Truncated checkpoint");
+   return string;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Writes a container of tids, such as a tid_set or a scheduler::schedule_t.
+
+template <typename container_t>
+void write_tids(std::ostream& os, const container_t& tids)
+{
+   write<std::uint64_t>(os, tids.size());
+   for (const auto& tid : tids)
+      write<std::int32_t>(os, tid);
+}
+
+template <typename container_t>
+container_t read_tids(std::istream& is)
+{
+   std::vector<program_model::Thread::tid_t> tids(read<std::uint64_t>(is));
+   for (auto& tid : tids)
+      tid = read<std::int32_t>(is);
+   return container_t(tids.begin(), tids.end());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+inline void write_sleepset(std::ostream& os, const SleepSet& sleepset)
+{
+   write_tids(os, sleepset.asleep());
+}
+
+inline SleepSet read_sleepset(std::istream& is)
+{
+   SleepSet sleepset;
+   for (const auto& tid : read_tids<tid_set>(is))
+      sleepset.add(tid);
+   return sleepset;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+/// @throws std::runtime_error if the checkpoint was written for a stack of a different depth.
+
+inline void check_depth(const std::size_t expected, const std::size_t depth)
+{
+   if (expected != depth)
+      throw std::runtime_error("Checkpoint does not match the replayed branch");
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace checkpoint
+} // end namespace exploration
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "vector_clock.hpp"
+#include "vector_clock_kernels.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <stdlib.h>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file clock_arena.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+namespace detail {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief An allocator that aligns its allocations at kernels::alignment bytes, which
+/// std::allocator does not guarantee before C++17.
+
+template <typename T>
+struct aligned_allocator
+{
+   using value_type = T;
+
+   aligned_allocator() = default;
+
+   template <typename U>
+   aligned_allocator(const aligned_allocator<U>&)
+   {
+   }
+
+   T* allocate(const std::size_t n)
+   {
+      void* values = nullptr;
+      if (posix_memalign(&values, kernels::alignment, n * sizeof(T)) != 0)
+         throw std::bad_alloc();
+      return static_cast<T*>(values);
+   }
+
+   void deallocate(T* values, const std::size_t) { free(values); }
+};
+
+template <typename T, typename U>
+bool operator==(const aligned_allocator<T>&, const aligned_allocator<U>&)
+{
+   return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const aligned_allocator<T>&, const aligned_allocator<U>&)
+{
+   return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace detail
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief A sequence of VectorClocks of equal width, stored row by row in a single contiguous
+/// buffer.
+/// @details Every row starts at kernels::alignment bytes and is padded with 0s up to the next
+/// row, such that the kernels never load a row across the boundary of its alignment. Rows are
+/// added and removed at the back only and are accessed through clock_views. A view is
+/// invalidated by the next push_back or set_width.
+
+class clock_arena
+{
+public:
+   using value_t = clock_view::value_t;
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @brief Constructs an arena of size 0-value rows of the given width.
+
+   clock_arena(const std::size_t width, const std::size_t size)
+   : mWidth(width)
+   , mStride(stride(width))
+   , mSize(size)
+   , mValues(mStride * size, 0)
+   {
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+   std::size_t width() const { return mWidth; }
+
+   std::size_t size() const { return mSize; }
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @details Like std::vector[], this subscript operator does not throw if size() > i and
+   /// yields undefined behaviour otherwise.
+
+   clock_view operator[](const std::size_t i) const
+   {
+      return clock_view(mValues.data() + i * mStride, mWidth);
+   }
+
+   clock_view back() const { return (*this)[size() - 1]; }
+
+   //-----------------------------------------------------------------------------------------------
+
+   void push_back(const clock_view& clock)
+   {
+      /// @pre clock.size() == width()
+      assert(clock.size() == mWidth);
+      mValues.resize(mValues.size() + mStride, 0);
+      std::copy(clock.cbegin(), clock.cend(), mValues.end() - mStride);
+      ++mSize;
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @brief Appends clock with the value at index replaced by value.
+
+   void push_back(const clock_view& clock, const std::size_t index, const value_t value)
+   {
+      push_back(clock);
+      mValues[mValues.size() - mStride + index] = value;
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+   void pop_back()
+   {
+      /// @pre size() > 0
+      assert(size() > 0);
+      mValues.resize(mValues.size() - mStride);
+      --mSize;
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+   /// @brief Narrows down or grows every row to the given width, keeping the first
+   /// min(width, width()) values and filling the others with 0.
+
+   void set_width(const std::size_t width)
+   {
+      if (width == mWidth)
+         return;
+      const std::size_t new_stride = stride(width);
+      values_t values(new_stride * mSize, 0);
+      for (std::size_t row = 0; row < mSize; ++row)
+      {
+         std::copy_n(mValues.begin() + row * mStride, std::min(width, mWidth),
+                     values.begin() + row * new_stride);
+      }
+      mValues.swap(values);
+      mWidth = width;
+      mStride = new_stride;
+   }
+
+   //-----------------------------------------------------------------------------------------------
+
+private:
+   using values_t = std::vector<value_t, detail::aligned_allocator<value_t>>;
+
+   /// @brief Returns the number of values from the start of one row to the next.
+
+   static std::size_t stride(const std::size_t width)
+   {
+      const std::size_t n = kernels::alignment / sizeof(value_t);
+      return (width + n - 1) / n * n;
+   }
+
+   std::size_t mWidth;
+   std::size_t mStride;
+
+   /// @brief The number of rows, which cannot be derived from mValues if mWidth is 0.
+   std::size_t mSize;
+
+   values_t mValues;
+
+}; // end class clock_arena
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
@@ -83,6 +83,25 @@ bool lock_unlock_same_object(const instruction_t& instruction_1, const instructi
            (is_unlock(instruction_1) && is_lock(instruction_2)));
 }
 
+//-------------------------------------------------------------------------------------------------
+
+bool is_memory_modification(const transition_record& record)
+{
+   return record.operation == operation_kind::store ||
+          record.operation == operation_kind::read_modify_write;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool lock_unlock_same_object(const transition_record& record_1, const transition_record& record_2)
+{
+   return record_1.operand == record_2.operand &&
+          ((record_1.operation == operation_kind::lock &&
+            record_2.operation == operation_kind::unlock) ||
+           (record_1.operation == operation_kind::unlock &&
+            record_2.operation == operation_kind::lock));
+}
+
 } // end namespace
 
 //-------------------------------------------------------------------------------------------------
@@ -105,6 +124,13 @@ bool Dependence::dependent(const instruction_t& instruction_1, const instruction
 
 //-------------------------------------------------------------------------------------------------
 
+bool Dependence::exclusive(const instruction_t& instruction)
+{
+   return is_memory_modification(instruction) || is_lock(instruction);
+}
+
+//-------------------------------------------------------------------------------------------------
+
 bool Dependence::coenabled(const instruction_t& instruction_1, const instruction_t& instruction_2)
 {
    return !(same_thread(instruction_1, instruction_2) ||
@@ -113,4 +139,26 @@ bool Dependence::coenabled(const instruction_t& instruction_1, const instruction
 
 //-------------------------------------------------------------------------------------------------
 
+bool Dependence::dependent(const transition_record& record_1, const transition_record& record_2)
+{
+   return record_1.tid == record_2.tid ||
+          (record_1.operand == record_2.operand && (exclusive(record_1) || exclusive(record_2)));
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool Dependence::exclusive(const transition_record& record)
+{
+   return is_memory_modification(record) || record.operation == operation_kind::lock;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+bool Dependence::coenabled(const transition_record& record_1, const transition_record& record_2)
+{
+   return !(record_1.tid == record_2.tid || lock_unlock_same_object(record_1, record_2));
+}
+
+//-------------------------------------------------------------------------------------------------
+
 } // end namespace exploration
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "transition_record.hpp"
 #include "visible_instruction.hpp"
 
 //-------------------------------------------------------------------------------------------------
@@ -29,6 +30,11 @@ public:
      */
    static bool dependent(const instruction_t&, const instruction_t&);
 
+   /// @brief Returns true iff the given instruction is dependent with every instruction on the
+   /// same object, i.e. iff it is a write or a lock. Two instructions on the same object of which
+   /// neither is exclusive are independent.
+   static bool exclusive(const instruction_t&);
+
    /**
      Following @cite flanagan-popl-95, we consider to instructions
      on an object that is not a lock to be co-enabled.
@@ -37,6 +43,13 @@ public:
      co-enabled even if they may not. However, this may decrease the obtained reduction.
      */
    static bool coenabled(const instruction_t&, const instruction_t&);
+
+   /// @brief Overloads of dependent, exclusive and coenabled on pre-decoded instructions, which
+   /// are equal to the results on the instructions they were decoded from.
+
+   static bool dependent(const transition_record&, const transition_record&);
+   static bool exclusive(const transition_record&);
+   static bool coenabled(const transition_record&, const transition_record&);
 };
 
 } // end namespace exploration
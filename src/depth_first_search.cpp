@@ -12,11 +12,9 @@ void dfs_state::add_to_done(const program_model::Thread::tid_t& tid)
 
 //--------------------------------------------------------------------------------------------------
     
-program_model::Tids dfs_state::undone(const program_model::Tids& tids) const
+tid_set dfs_state::undone(const tid_set& tids) const
 {
-   program_model::Tids undone;
-   std::set_difference(tids.begin(), tids.end(), mDone.begin(), mDone.end(),
-                       std::inserter(undone, undone.end()));
+   const tid_set undone = tids - mDone;
    DEBUGF("dfs_state", "undone", tids, " = " << tids << " \\ " << mDone << " = " << undone << "\n");
    return undone;
 }
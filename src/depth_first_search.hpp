@@ -9,11 +9,17 @@
 #include "state.hpp"
 #include "transition_io.hpp"
 
+// EXPLORATION
+#include "checkpoint.hpp"
+#include "tid_set.hpp"
+
 // UTILS
 #include "color_output.hpp"
 #include "container_output.hpp"
 #include "debug.hpp"
 
+#include <algorithm>
+
 //--------------------------------------------------------------------------------------------------
 /// @file depth_first_search.hpp
 /// @author Susanne van den Elsen
@@ -31,11 +37,12 @@ public:
    dfs_state() = default;
         
    void add_to_done(const program_model::Thread::tid_t& tid);
-   program_model::Tids undone(const program_model::Tids& T) const;
+   const tid_set& done() const { return mDone; }
+   tid_set undone(const tid_set& T) const;
         
 private:
         
-   program_model::Tids mDone;
+   tid_set mDone;
         
    friend std::ostream& operator<<(std::ostream&, const dfs_state&);
         
@@ -64,6 +71,7 @@ public:
 	explicit depth_first_search(const execution_t& E, Args ... args)
    : mState({ dfs_state() })
 	, mReduction(E, std::forward<Args>(args) ...) 
+   , mFloor(0)
    { 
    }
 		
@@ -89,17 +97,6 @@ public:
    
    //-----------------------------------------------------------------------------------------------
         
-   /// @brief Wrapper of mReduction.restore_state, checking preconditions.
-
-   inline void restore_state(const transition_t& transition)
-   {
-      /// @pre mState.size() > t.index()
-      assert(mState.size() > transition.index());
-      mReduction.restore_state(transition);
-   }
-   
-   //-----------------------------------------------------------------------------------------------
-        
    /// @brief Adds a new dfs_state at the back of mState and calls mReduction.update_state.
 
    void update_state(const execution_t& execution, const transition_t& transition)
@@ -135,18 +132,18 @@ public:
         
    /// @brief Backtracks the states along the current execution until it encounters i such that 
    /// exists tid in (mMode.pool(i) \ mState[i-1].done()). Then it returns the new schedule 
-   /// pre(E, i).tid.
+   /// pre(E, i).tid, possibly extended by mReduction.extend_schedule.
    
    //-----------------------------------------------------------------------------------------------
 
    scheduler::schedule_t new_schedule(execution_t& execution, scheduler::schedule_t& schedule)
    {
-      while (!execution.empty()) 
+      while (execution.size() > mFloor) 
       {
          update_after_exploration(execution.last());
          pop_back(execution, schedule);
 			DEBUG(execution.final() << "\n");
-         program_model::Tids pool_undone = mState.back().undone(mReduction.pool(execution));
+         tid_set pool_undone = mState.back().undone(mReduction.pool(execution));
          if (!pool_undone.empty()) 
          {
             const auto next = mReduction.select_from_pool(execution, pool_undone);
@@ -157,7 +154,9 @@ public:
                /// (i.e. mReduction.pool(E) is a subset of E.final().enabled())
                assert(execution.final().is_enabled(next));
                schedule.push_back(next);
-               break;
+               mReduction.extend_schedule(execution, schedule);
+               DEBUG("\tnew schedule= " << schedule << "\n");
+               return schedule;
             } 
             else 
             {
@@ -165,12 +164,93 @@ public:
             }
          }
       }
-      DEBUG("\tnew schedule= " << schedule << "\n");
-      return schedule;
+      DEBUG("\tnew schedule= {}\n");
+      return {};
+   }
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Restricts the traversal to the subtree rooted at the floor'th state of the first 
+   /// execution, i.e. new_schedule never backtracks to a state with index smaller than floor.
+
+   void set_floor(const std::size_t floor) { mFloor = floor; }
+   std::size_t floor() const { return mFloor; }
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Returns { prefix(schedule, i).tid | tid in pool(i) \ (mState[i].done U schedule[i]) } 
+   /// for the smallest i >= mFloor for which this set is non-empty and raises mFloor to i+1, so 
+   /// that the returned schedules are no longer explored by this depth_first_search.
+   /// @note Requires reduction_t to provide pool(execution, index).
+   
+   std::vector<scheduler::schedule_t> split(const execution_t& execution, 
+                                            const scheduler::schedule_t& schedule)
+   {
+      /// @pre schedule extends execution (i.e. called between new_schedule and replay). The 
+      /// extension may consist of several tids (e.g. the wakeup sequence of Optimal).
+      assert(schedule.size() > execution.size());
+      std::vector<scheduler::schedule_t> split{};
+      const auto levels = std::min<std::size_t>(schedule.size(), mState.size());
+      for (auto level = mFloor; level < levels && split.empty(); ++level)
+      {
+         tid_set undone = mState[level].undone(mReduction.pool(execution, level));
+         undone.erase(schedule[level]);
+         for (const auto& tid : undone)
+         {
+            split.emplace_back(schedule.begin(), schedule.begin() + level);
+            split.back().push_back(tid);
+            mFloor = level + 1;
+         }
+      }
+      DEBUGF(outputname(), "split", schedule, " = " << split.size() << " schedules\n");
+      return split;
+   }
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Writes mFloor, the done sets of mState and the state of mReduction to a checkpoint.
+   /// @pre Called between new_schedule and replay.
+
+   void save(std::ostream& os) const
+   {
+      checkpoint::write<std::uint64_t>(os, mFloor);
+      checkpoint::write<std::uint64_t>(os, mState.size());
+      for (const auto& state : mState)
+      {
+         checkpoint::write_tids(os, state.done());
+      }
+      mReduction.save(os);
+   }
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Restores the state written by save, after update_state rebuilt mState along the 
+   /// branch that was current when the checkpoint was written.
+
+   void restore(std::istream& is)
+   {
+      mFloor = checkpoint::read<std::uint64_t>(is);
+      checkpoint::check_depth(checkpoint::read<std::uint64_t>(is), mState.size());
+      for (auto& state : mState)
+      {
+         state = dfs_state();
+         for (const auto& tid : checkpoint::read_tids<tid_set>(is))
+         {
+            state.add_to_done(tid);
+         }
+      }
+      mReduction.restore(is);
    }
    
    //-----------------------------------------------------------------------------------------------
         
+   const dfs_state& state(const std::size_t index) const { return mState[index]; }
+   
+   reduction_t& reduction() { return mReduction; }
+   const reduction_t& reduction() const { return mReduction; }
+   
+   //-----------------------------------------------------------------------------------------------
+        
    /// @brief Wrapper of mReduction.close.
    void close(const std::string& statistics) const;
         
@@ -196,6 +276,9 @@ private:
    
    std::vector<dfs_state> mState;
    reduction_t mReduction;
+   
+   /// @brief The number of states at the bottom of mState that new_schedule does not backtrack to.
+   std::size_t mFloor;
         
 }; // end class template depth_first_search<Reduction>
 
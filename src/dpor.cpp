@@ -1,15 +1,36 @@
 
 #include "dpor.hpp"
+#include "checkpoint.hpp"
+#include "scheduler_input.hpp"
 
 // UTILS
 #include "utils_io.hpp"
 
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+
 namespace exploration
 {
 //--------------------------------------------------------------------------------------------------
 
 dpor_statistics::dpor_statistics()
-: mNrSleepSetBlocked(0) { }
+: mNrSleepSetBlocked(0)
+, mNrSkippedBacktrackQueries(0)
+, mNrSleepSetBlockedPruned(0)
+, mNrForwarded(0) { }
+
+//--------------------------------------------------------------------------------------------------
+
+dpor_statistics::dpor_statistics(const unsigned int nr_sleepset_blocked,
+                                 const unsigned int nr_skipped_backtrack_queries,
+                                 const unsigned int nr_sleepset_blocked_pruned,
+                                 const unsigned int nr_forwarded)
+: mNrSleepSetBlocked(nr_sleepset_blocked)
+, mNrSkippedBacktrackQueries(nr_skipped_backtrack_queries)
+, mNrSleepSetBlockedPruned(nr_sleepset_blocked_pruned)
+, mNrForwarded(nr_forwarded) { }
 
 //--------------------------------------------------------------------------------------------------
     
@@ -27,18 +48,68 @@ void dpor_statistics::increase_nr_sleepset_blocked()
 
 //--------------------------------------------------------------------------------------------------
     
+unsigned int dpor_statistics::nr_sleepset_blocked_pruned() const
+{
+   return mNrSleepSetBlockedPruned;
+}
+
+//--------------------------------------------------------------------------------------------------
+    
+void dpor_statistics::increase_nr_sleepset_blocked_pruned()
+{
+   ++mNrSleepSetBlockedPruned;
+}
+
+//--------------------------------------------------------------------------------------------------
+    
+unsigned int dpor_statistics::nr_skipped_backtrack_queries() const
+{
+   return mNrSkippedBacktrackQueries;
+}
+
+//--------------------------------------------------------------------------------------------------
+    
+void dpor_statistics::increase_nr_skipped_backtrack_queries(const unsigned int nr)
+{
+   mNrSkippedBacktrackQueries += nr;
+}
+
+//--------------------------------------------------------------------------------------------------
+    
+unsigned int dpor_statistics::nr_forwarded() const
+{
+   return mNrForwarded;
+}
+
+//--------------------------------------------------------------------------------------------------
+    
+void dpor_statistics::increase_nr_forwarded()
+{
+   ++mNrForwarded;
+}
+
+//--------------------------------------------------------------------------------------------------
+    
 std::ostream& operator<<(std::ostream& os, const dpor_statistics& stats)
 {
    os << "nr_sleepset_blocked\t" << stats.nr_sleepset_blocked() << std::endl;
+   os << "nr_skipped_backtrack_queries\t" << stats.nr_skipped_backtrack_queries() << std::endl;
+   os << "nr_sleepset_blocked_pruned\t" << stats.nr_sleepset_blocked_pruned() << std::endl;
+   os << "nr_forwarded\t" << stats.nr_forwarded() << std::endl;
    return os;
 }
 
 //--------------------------------------------------------------------------------------------------
 	
-dpor_base::dpor_base(const execution_t& execution) 
+dpor_base::dpor_base(const execution_t& execution, const bool thread_local_objects) 
 : mState({ SufficientSet() })
 , mHB(execution) 
+, mFloor(0)
+, mSeeds()
+, mForwarded()
+, mLastAnalysed(0)
 { 
+	mHB.filter_thread_local(thread_local_objects);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -54,7 +125,21 @@ void dpor_base::write_scheduler_files() const
 {
 	/// @pre !mState.empty()
 	assert(!mState.empty());
-	utils::io::write_to_file("schedules/sleepset.txt", mState.back().sleepset());
+	// Before the first replay of a job of length mFloor, mState does not yet contain the state in 
+	// which the job's last tid is taken. Its sleepset is only known if that state was seeded; 
+	// a seed of a shallower state does not carry over, as the replay wakes up the threads in the 
+	// sleepset from that last state onwards only.
+	if (mFloor > 0 && mState.size() <= mFloor) {
+		const auto seed = mSeeds.find(mFloor - 1);
+		scheduler::input::write(
+			scheduler::input::sleepset, seed != mSeeds.end() ? seed->second : SleepSet());
+		return;
+	}
+	if (mWakeupSleep) {
+		scheduler::input::write(scheduler::input::sleepset, *mWakeupSleep);
+		return;
+	}
+	scheduler::input::write(scheduler::input::sleepset, mState.back().sleepset());
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -62,15 +147,8 @@ void dpor_base::write_scheduler_files() const
 void dpor_base::reset()
 {
 	mHB.reset();
-}
-
-//--------------------------------------------------------------------------------------------------
-	
-void dpor_base::restore_state(const transition_t& transition)
-{
-	/// @pre mState.size() > transition.index()
-	assert(mState.size() > transition.index());
-	mHB.restore(transition.index());
+	mWakeupSleep = boost::none;
+	mBacktracked.clear();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -87,6 +165,26 @@ void dpor_base::update_statistics(const execution_t& execution)
 void dpor_base::close(const std::string& statistics_file) const
 {
    utils::io::write_to_file(statistics_file, mStatistics, std::ios::app);
+   const auto object_statistics_file =
+      boost::filesystem::path(statistics_file).parent_path() / "object_statistics.txt";
+   std::ofstream ofs(object_statistics_file.string());
+   mHB.operands().dump(ofs);
+}
+
+//--------------------------------------------------------------------------------------------------
+	
+void dpor_base::seed(const std::size_t index, const SleepSet& sleepset)
+{
+	mSeeds[index] = sleepset;
+}
+
+//--------------------------------------------------------------------------------------------------
+	
+std::vector<scheduler::schedule_t> dpor_base::take_forwarded()
+{
+	std::vector<scheduler::schedule_t> forwarded;
+	forwarded.swap(mForwarded);
+	return forwarded;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -96,6 +194,10 @@ void dpor_base::update_state(const execution_t& execution, const transition_t& t
 	/// @pre mState.size() == transition.index()
 	assert(mState.size() == transition.index());
    const auto tid = boost::apply_visitor(program_model::get_tid(), transition.instr());
+   const auto seed = mSeeds.find(transition.index()-1);
+   if (seed != mSeeds.end()) {
+      mState.back().set_sleepset(seed->second);
+   }
    mState.back().add_to_backtrack(tid);
 	mState.emplace_back(SufficientSet{{}, SleepSet(mState.back().sleepset(), transition, Dependence())});
 	mHB.update(transition.index());
@@ -112,6 +214,169 @@ SufficientSet& dpor_base::pre_of_transition(const std::size_t index)
 
 //--------------------------------------------------------------------------------------------------
 	
+tid_set dpor_base::unchanged_threads(const execution_t& execution, const std::size_t index) const
+{
+	tid_set unchanged{};
+	if (index < 2 || mLastAnalysed + 1 != index) {
+		return unchanged;
+	}
+	const transition_t& previous = execution[index-1];
+	const auto tid = boost::apply_visitor(program_model::get_tid(), previous.instr());
+	const program_model::State& pre = execution[index].pre();
+	std::for_each(
+		previous.pre().next_cbegin(), previous.pre().next_cend(),
+		[&unchanged, &previous, &tid, &pre] (const auto& next) {
+			if (next.first != tid && pre.has_next(next.first) &&
+				 !Dependence::dependent(previous.instr(), next.second.instr)) {
+				unchanged.insert(next.first);
+			}
+		}
+	);
+	return unchanged;
+}
+
+//--------------------------------------------------------------------------------------------------
+	
+void dpor_base::forward(const execution_t& execution, const std::size_t index, const tid_set& backtrack)
+{
+	const tid_set& added = pre_of_transition(index).backtrack();
+	scheduler::schedule_t prefix;
+	for (std::size_t i = 1; i < index; ++i) {
+		prefix.push_back(boost::apply_visitor(program_model::get_tid(), execution[i].instr()));
+	}
+	for (const auto& tid : added) {
+		if (backtrack.count(tid) == 0) {
+			mForwarded.push_back(prefix);
+			mForwarded.back().push_back(tid);
+			mStatistics.increase_nr_forwarded();
+			DEBUGF(outputname(), "forward", mForwarded.back(), "\n");
+		}
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+	
+void dpor_base::record_backtracked(const transition_t& transition)
+{
+	const auto tid = boost::apply_visitor(program_model::get_tid(), transition.instr());
+	const program_model::State& pre = transition.pre();
+	const program_model::State& post = transition.post();
+	const bool memory_access =
+		boost::get<program_model::memory_instruction>(&transition.instr()) != nullptr;
+	// Covers both the creation of a thread and the return of a thread from a join
+	const bool adds_thread = std::any_of(
+		post.next_cbegin(), post.next_cend(),
+		[&pre] (const auto& next) { return !pre.has_next(next.first); }
+	);
+	const bool all_enabled = std::all_of(
+		pre.next_cbegin(), pre.next_cend(),
+		[&pre] (const auto& next) { return pre.is_enabled(next.first); }
+	);
+	mBacktracked.push_back({ 
+		tid, transition.instr(), !post.has_next(tid),
+		memory_access && !adds_thread && all_enabled
+	});
+}
+
+//--------------------------------------------------------------------------------------------------
+	
+bool dpor_base::sleepset_blocked(const execution_t& execution,
+                                 const program_model::Thread::tid_t tid) const
+{
+	// The steps of tid in the backtracked execution, up to the one it terminates with
+	std::vector<const Dependence::instruction_t*> steps;
+	std::vector<const Dependence::instruction_t*> others;
+	bool terminates = false;
+	for (auto it = mBacktracked.rbegin(); it != mBacktracked.rend() && !terminates; ++it) {
+		if (!it->thread_local_step) {
+			return false;
+		}
+		if (it->tid != tid) {
+			if (it->terminates) {
+				return false;
+			}
+			others.push_back(&it->instr);
+			continue;
+		}
+		const bool independent = std::none_of(
+			others.begin(), others.end(),
+			[&it] (const auto* other) { return Dependence::dependent(*other, it->instr); }
+		);
+		if (!independent) {
+			return false;
+		}
+		steps.push_back(&it->instr);
+		terminates = it->terminates;
+	}
+	if (!terminates) {
+		return false;
+	}
+	const program_model::State& state = execution.final();
+	const SleepSet& sleepset = mState.back().sleepset();
+	bool enabled = false;
+	for (auto next = state.next_cbegin(); next != state.next_cend(); ++next) {
+		if (next->first == tid) {
+			continue;
+		}
+		if (!state.is_enabled(next->first)) {
+			return false;
+		}
+		const bool affected = std::any_of(
+			steps.begin(), steps.end(),
+			[&next] (const auto* step) { return Dependence::dependent(*step, next->second.instr); }
+		);
+		if (affected || sleepset.is_awake(next->first)) {
+			return false;
+		}
+		enabled = true;
+	}
+	// Without other enabled threads the replay ends when tid terminates instead of blocking
+	return enabled;
+}
+
+//--------------------------------------------------------------------------------------------------
+	
+void dpor_base::save(std::ostream& os) const
+{
+	checkpoint::write<std::uint32_t>(os, mStatistics.nr_sleepset_blocked());
+	checkpoint::write<std::uint32_t>(os, mStatistics.nr_skipped_backtrack_queries());
+	checkpoint::write<std::uint32_t>(os, mStatistics.nr_sleepset_blocked_pruned());
+	checkpoint::write<std::uint32_t>(os, mStatistics.nr_forwarded());
+	checkpoint::write<std::uint64_t>(os, mState.size());
+	for (const auto& state : mState) {
+		checkpoint::write_tids(os, state.backtrack());
+		checkpoint::write_sleepset(os, state.sleepset());
+	}
+	checkpoint::write<bool>(os, static_cast<bool>(mWakeupSleep));
+	if (mWakeupSleep) {
+		checkpoint::write_sleepset(os, *mWakeupSleep);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+	
+void dpor_base::restore(std::istream& is)
+{
+	const auto nr_sleepset_blocked = checkpoint::read<std::uint32_t>(is);
+	const auto nr_skipped_backtrack_queries = checkpoint::read<std::uint32_t>(is);
+	const auto nr_sleepset_blocked_pruned = checkpoint::read<std::uint32_t>(is);
+	mStatistics = dpor_statistics(nr_sleepset_blocked, nr_skipped_backtrack_queries,
+	                              nr_sleepset_blocked_pruned, checkpoint::read<std::uint32_t>(is));
+	checkpoint::check_depth(checkpoint::read<std::uint64_t>(is), mState.size());
+	for (auto& state : mState) {
+		const auto backtrack = checkpoint::read_tids<tid_set>(is);
+		state = SufficientSet(backtrack, checkpoint::read_sleepset(is));
+	}
+	mWakeupSleep = boost::none;
+	if (checkpoint::read<bool>(is)) {
+		mWakeupSleep = checkpoint::read_sleepset(is);
+	}
+	// As after new_schedule, the next update_state starts a new run of analysed Transitions
+	mLastAnalysed = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+	
 const std::string dpor_base::name = "dpor";
 
 //--------------------------------------------------------------------------------------------------
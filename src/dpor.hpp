@@ -1,15 +1,22 @@
 #pragma once
 
 // EXPLORATION
+#include "exploration.hpp"
 #include "sufficient_sets/sufficient_set.hpp"
 
 // SCHEDULER
+#include "schedule.hpp"
 #include "scheduler_settings.hpp"
 
 // PROGRAM_MODEL
 #include "execution.hpp"
 #include "transition_io.hpp"
 
+#include <boost/optional.hpp>
+
+#include <map>
+#include <type_traits>
+
 //-----------------------------------------------------------------------------------------------100
 /// @file dpor.hpp
 /// @author Susanne van den Elsen
@@ -25,13 +32,33 @@ class dpor_statistics
 public:
         
    dpor_statistics();
+   dpor_statistics(const unsigned int nr_sleepset_blocked,
+                   const unsigned int nr_skipped_backtrack_queries,
+                   const unsigned int nr_sleepset_blocked_pruned,
+                   const unsigned int nr_forwarded);
 		
    unsigned int nr_sleepset_blocked() const;
    void increase_nr_sleepset_blocked();
+   
+   /// @brief The number of schedules that were not replayed because dpor predicted that the 
+   /// sleepset would block them.
+   unsigned int nr_sleepset_blocked_pruned() const;
+   void increase_nr_sleepset_blocked_pruned();
+   
+   unsigned int nr_skipped_backtrack_queries() const;
+   void increase_nr_skipped_backtrack_queries(const unsigned int nr);
+   
+   /// @brief The number of backtrack points that were added to states below the floor and 
+   /// forwarded to the explorers owning those states.
+   unsigned int nr_forwarded() const;
+   void increase_nr_forwarded();
 
 private:
         
    unsigned int mNrSleepSetBlocked;
+   unsigned int mNrSkippedBacktrackQueries;
+   unsigned int mNrSleepSetBlockedPruned;
+   unsigned int mNrForwarded;
         
 }; // end class dpor_statistics
 
@@ -47,25 +74,49 @@ public:
 		
 	using execution_t = program_model::Execution;
    using transition_t = typename execution_t::transition_t;
+#ifdef TREE_CLOCKS
+   using happens_before_t = HappensBefore<Dependence, tree_clock>;
+#else
+   using happens_before_t = HappensBefore<Dependence>;
+#endif
 		
-	explicit dpor_base(const execution_t&);
+	/// @param thread_local_objects Whether mHB collapses the Transitions on thread-local objects 
+	/// out of the analysis.
+	explicit dpor_base(const execution_t&, const bool thread_local_objects = false);
 		
 	/// @brief Sets the selection strategy to SleepSets.
 	static scheduler::SchedulerSettings scheduler_settings();
 		
-	/// @brief Writes the sleepset of mState.back() to file schedules/sleepset.txt.
+	/// @brief Hands the sleepset of mState.back() to the next replay through scheduler::input, or 
+	/// the sleepset after the wakeup sequence if extend_schedule extended the schedule. The first 
+	/// replay of a job with floor f gets the sleepset seeded for state f-1, if any.
 	void write_scheduler_files() const;
 		
-	/// @brief Wrapper of mHB.reset.
+	/// @brief Wrapper of mHB.reset that also discards the sleepset written for the last schedule.
 	void reset();
 		
-	/// @brief Wrapper of mHB.restore, checking preconditions.
-	void restore_state(const transition_t& transition);
-		
 	/// @brief Calls mStatistics.increase_nr_sleepset_blocked iff E.status is BLOCKED.
 	void update_statistics(const execution_t& execution);
 		
+	/// @brief Appends mStatistics to statistics_file and writes the statistics per operand of mHB 
+	/// to object_statistics.txt in the same directory.
 	void close(const std::string& statistics_file) const;
+	
+	const SufficientSet& sufficient_set(const std::size_t index) const { return mState[index]; }
+	
+	const dpor_statistics& statistics() const { return mStatistics; }
+	
+	/// @brief Marks the states with index smaller than floor as owned by another explorer. 
+	/// Backtrack points added to those states are collected instead of explored locally.
+	void set_floor(const std::size_t floor) { mFloor = floor; }
+	
+	/// @brief Replaces the sleepset that the state with the given index gets when it is created 
+	/// (i.e. when replaying a prefix that was explored by another explorer) by sleepset.
+	void seed(const std::size_t index, const SleepSet& sleepset);
+	
+	/// @brief Returns and clears { prefix(E, i).tid | tid was added to the backtrack set of the 
+	/// i'th state with i < mFloor }.
+	std::vector<scheduler::schedule_t> take_forwarded();
 		
 protected:
 	
@@ -78,12 +129,77 @@ protected:
 	
 	SufficientSet& pre_of_transition(const std::size_t index);
 	
+	/// @brief Returns the threads tid whose backtrack points at index equal those at index-1, 
+	/// because tid did not execute execution[index-1], its next instruction is independent of 
+	/// execution[index-1] and index-1 was analysed in the same execution. This coarsens the 
+	/// backtrack analysis of a run of steps of one thread into the analysis of its first step for 
+	/// every other thread whose next instruction is independent of the whole run.
+	tid_set unchanged_threads(const execution_t& execution, const std::size_t index) const;
+	
+	/// @brief Adds { prefix(execution, index-1).tid | tid in pre(index).backtrack \ backtrack } 
+	/// to mForwarded.
+	void forward(const execution_t& execution, const std::size_t index, const tid_set& backtrack);
+	
+	/// @brief Adds what sleepset_blocked needs to know about transition, which new_schedule 
+	/// backtracks over, to mBacktracked.
+	void record_backtracked(const transition_t& transition);
+	
+	/// @brief Returns true only if the replay of the current schedule extended with tid is blocked 
+	/// by the sleepset of mState.back().
+	/// @details Looks ahead along the steps that tid took after the current state in the 
+	/// backtracked execution, as far as they are independent of the steps of other threads 
+	/// before them, so that tid takes the same steps when it is scheduled first. The replay is 
+	/// blocked if tid terminates with these steps, while no step of tid is dependent with the 
+	/// next instruction of another thread (and hence wakes it up, enables or disables it) and all 
+	/// threads that are enabled in the current state are asleep.
+	/// @note Dependence only relates memory and lock accesses, whereas creating a thread enables 
+	/// it and terminating a thread enables the threads that join it. The look ahead is therefore 
+	/// restricted to thread-local steps (see backtracked_transition::thread_local_step) of tid 
+	/// and of the threads in between, none of which may terminate before tid, and to current 
+	/// states in which no thread is disabled.
+	bool sleepset_blocked(const execution_t& execution,
+	                      const program_model::Thread::tid_t tid) const;
+	
+	/// @brief Writes mStatistics, the backtrack sets and sleepsets of mState and mWakeupSleep to a 
+	/// checkpoint.
+	void save(std::ostream& os) const;
+	
+	/// @brief Restores the state written by save, after update_state rebuilt mState along the 
+	/// branch that was current when the checkpoint was written.
+	void restore(std::istream& is);
+	
 	static const std::string name;
 	static std::string outputname();
 		
 	std::vector<SufficientSet> mState;
-	HappensBefore<Dependence> mHB;
+	happens_before_t mHB;
 	dpor_statistics mStatistics;
+	std::size_t mFloor;
+	std::map<std::size_t, SleepSet> mSeeds;
+	std::vector<scheduler::schedule_t> mForwarded;
+	
+	/// @brief The index of the last Transition analysed by update_state in the current execution, 
+	/// or 0 after backtracking.
+	std::size_t mLastAnalysed;
+	
+	/// @brief The sleepset of mState.back() propagated along the wakeup sequence appended to the 
+	/// schedule by extend_schedule, if any.
+	boost::optional<SleepSet> mWakeupSleep;
+	
+	struct backtracked_transition
+	{
+		program_model::Thread::tid_t tid;
+		Dependence::instruction_t instr;
+		/// @brief Whether the thread has no next instruction after the Transition.
+		bool terminates;
+		/// @brief Whether the Transition is a memory access, taken in a State in which no thread 
+		/// is disabled, after which no thread has a next Transition that it had not before.
+		bool thread_local_step;
+	};
+	
+	/// @brief The Transitions that new_schedule backtracked over since the last replay, from the 
+	/// last one down to the one after the current state.
+	std::vector<backtracked_transition> mBacktracked;
 		
 }; // end class dpor_base
 
@@ -108,6 +224,15 @@ public:
 	{ 
 	}
 	
+	/// @brief Constructs a dpor with the dpor options of settings, forwarding args to 
+	/// sufficient_set_t.
+   template<typename ... Args>
+   dpor(const execution_t& execution, const Settings& settings, Args ... args)
+   : dpor_base(execution, settings.thread_local_objects)
+	, mSufficientSet(std::forward<Args>(args) ...) 
+	{ 
+	}
+	
 	//-----------------------------------------------------------------------------------------------
        
 	/// @brief Wrapper for mSufficientSet::check_valid.
@@ -122,13 +247,26 @@ public:
    {
 		dpor_base::update_state(execution, transition);
 		mSufficientSet.update_state(execution, transition);
-      BacktrackPoints Points = mSufficientSet.backtrack_points(execution, transition.index(), mHB);
+      BacktrackPoints Points = backtrack_points(
+         execution, transition.index(),
+         std::integral_constant<bool, sufficient_set_t::skip_unchanged_threads>());
+      mLastAnalysed = transition.index();
       DEBUG("\tBacktrackPoints = " << Points << "\n");
       for (const auto& point : Points) 
 		{
-         mSufficientSet.add_backtrack_point(execution, transition.index(), mState, mHB, point);
-         DEBUG("\t" << to_string_pre(point.index) 
-					<< ".backtrack = " << pre_of_transition(point.index).backtrack() << "\n");
+         if (static_cast<std::size_t>(point.index) > mFloor)
+         {
+            mSufficientSet.add_backtrack_point(execution, transition.index(), mState, mHB, point);
+            DEBUG("\t" << to_string_pre(point.index) 
+                  << ".backtrack = " << pre_of_transition(point.index).backtrack() << "\n");
+         }
+         else
+         {
+            // pre(point.index) is explored by another explorer
+            const tid_set backtrack = pre_of_transition(point.index).backtrack();
+            mSufficientSet.add_backtrack_point(execution, transition.index(), mState, mHB, point);
+            forward(execution, point.index, backtrack);
+         }
       }
    }
 	
@@ -147,6 +285,47 @@ public:
              to_string_pre_state(transition) << ".sleep += { " << tid << " } = "
              << mState.back().sleepset());
       mSufficientSet.update_after_exploration(transition, mState[transition.index()-1]);
+      if (sufficient_set_t::prune_sleepset_blocked)
+      {
+         record_backtracked(transition);
+      }
+   }
+	
+	//-----------------------------------------------------------------------------------------------
+   
+   /// @brief Calls dpor_base::save and sufficient_set_t::save.
+
+   void save(std::ostream& os) const
+   {
+      dpor_base::save(os);
+      mSufficientSet.save(os);
+   }
+   
+   //-----------------------------------------------------------------------------------------------
+   
+   /// @brief Calls dpor_base::restore and sufficient_set_t::restore.
+
+   void restore(std::istream& is)
+   {
+      dpor_base::restore(is);
+      mSufficientSet.restore(is);
+   }
+	
+	//-----------------------------------------------------------------------------------------------
+        
+   /// @brief Appends the wakeup sequence that sufficient_set_t prescribes after schedule.back() in 
+   /// the current state to schedule, so that the replay follows it before the scheduler selects 
+   /// threads itself.
+
+   void extend_schedule(const execution_t& execution, scheduler::schedule_t& schedule)
+   {
+      SleepSet sleep = mState.back().sleepset();
+      const auto sequence = mSufficientSet.wakeup_sequence(execution.final(), schedule.back(), sleep);
+      if (!sequence.empty())
+      {
+         schedule.insert(schedule.end(), sequence.begin(), sequence.end());
+         mWakeupSleep = sleep;
+      }
    }
 	
 	//-----------------------------------------------------------------------------------------------
@@ -154,11 +333,20 @@ public:
    /// @details Returns state.sleepset.awake(state.backtrack \ state.done) if sleepsets are enabled 
 	/// and state.backtrack \ state.done otherwise.
 
-   program_model::Tids pool(const execution_t&)
+   tid_set pool(const execution_t& execution)
+	{
+      return pool(execution, mState.size()-1);
+   }
+	
+	//-----------------------------------------------------------------------------------------------
+        
+   /// @brief Returns the pool of the index'th state of the current execution.
+
+   tid_set pool(const execution_t&, const std::size_t index)
 	{
-      SufficientSet& s = mState.back();
-		program_model::Tids sufficient = s.sleepset().awake(s.backtrack());
-      mSufficientSet.add_to_pool(sufficient);
+      SufficientSet& s = mState[index];
+		tid_set sufficient = s.sleepset().awake(s.backtrack());
+      mSufficientSet.add_to_pool(sufficient, index);
       return sufficient;
    }
 	
@@ -167,17 +355,31 @@ public:
    /// @brief Selects the first program_model::Thread::tid_t from the given pool that satisfies 
 	/// the condition set by sufficient_set_t. If no such program_model::Thread::tid_t is found, it 
 	/// returns -1.
+	/// @details If sufficient_set_t::prune_sleepset_blocked, a tid for which sleepset_blocked 
+	/// holds is not selected, but added to the sleepset of mState.back() as if its execution was 
+	/// explored.
 
-   program_model::Thread::tid_t select_from_pool(const execution_t& execution, const Tids& pool)
+   program_model::Thread::tid_t select_from_pool(const execution_t& execution, const tid_set& pool)
    {
       /// @pre !pool.empty()
       assert(!pool.empty());
       DEBUGF(outputname(), "select_from_pool", pool, "\n");
-      auto it = std::find_if(pool.begin(), pool.end(), [this, &execution] (const auto& tid) 
-									  {
-                    					return mSufficientSet.condition(execution, mState.back(), tid);
-                				  });
-      return (it != pool.end()) ? *it : -1;
+      for (const auto& tid : pool)
+      {
+         if (!mSufficientSet.condition(execution, mState.back(), tid))
+         {
+            continue;
+         }
+         if (sufficient_set_t::prune_sleepset_blocked && sleepset_blocked(execution, tid))
+         {
+            DEBUG("\tpruned sleepset blocked " << tid << "\n");
+            mState.back().sleepset().add(tid);
+            mStatistics.increase_nr_sleepset_blocked_pruned();
+            continue;
+         }
+         return tid;
+      }
+      return -1;
    }
 	
 	//-----------------------------------------------------------------------------------------------
@@ -191,6 +393,23 @@ public:
 private:
 		
    sufficient_set_t mSufficientSet;
+   
+   /// @brief Returns the backtrack points of sufficient_set_t at index, skipping the threads 
+   /// given by unchanged_threads, which are counted as skipped queries.
+   BacktrackPoints backtrack_points(const execution_t& execution, const std::size_t index, 
+                                    std::true_type)
+   {
+      const tid_set unchanged = unchanged_threads(execution, index);
+      mStatistics.increase_nr_skipped_backtrack_queries(unchanged.size());
+      return mSufficientSet.backtrack_points(execution, index, mHB, unchanged);
+   }
+   
+   /// @brief Returns the backtrack points of sufficient_set_t at index.
+   BacktrackPoints backtrack_points(const execution_t& execution, const std::size_t index, 
+                                    std::false_type)
+   {
+      return mSufficientSet.backtrack_points(execution, index, mHB);
+   }
 		
 }; // end class template dpor<sufficient_set_t>
 
@@ -210,6 +429,7 @@ void dpor<sufficient_set_t>::pop_back()
 	mState.pop_back();
 	mHB.pop_back();
 	mSufficientSet.pop_back();
+	mLastAnalysed = 0;
 }	
 
 //-------------------------------------------------------------------------------------------------- 
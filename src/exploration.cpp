@@ -1,5 +1,8 @@
 
 #include "exploration.hpp"
+#include "instrumentation_cache.hpp"
+
+#include <sys/resource.h>
 
 
 namespace exploration {
@@ -38,6 +41,52 @@ void move_records(unsigned int nr, const boost::filesystem::path& source_dir)
    }
 }
 
+//--------------------------------------------------------------------------------------------------
+
+std::size_t peak_resident_set_size()
+{
+   // On Linux ru_maxrss is in KiB, and for RUSAGE_CHILDREN it is that of the largest child
+   rusage self{};
+   rusage children{};
+   getrusage(RUSAGE_SELF, &self);
+   getrusage(RUSAGE_CHILDREN, &children);
+   return static_cast<std::size_t>(self.ru_maxrss) + static_cast<std::size_t>(children.ru_maxrss);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::future<void> write_checkpoint(std::string checkpoint, const boost::filesystem::path& file)
+{
+   return std::async(std::launch::async, [checkpoint = std::move(checkpoint), file]() {
+      // A crash while writing leaves the previous checkpoint intact
+      const boost::filesystem::path temporary = file.string() + ".tmp";
+      {
+         std::ofstream ofs(temporary.string(), std::ios::binary);
+         ofs.write(checkpoint.data(), checkpoint.size());
+         if (!ofs.flush())
+            throw std::runtime_error("Could not write " + temporary.string());
+      }
+      boost::filesystem::rename(temporary, file);
+   });
+}
+
+//--------------------------------------------------------------------------------------------------
+
+scheduler::program_t instrument(const scheduler::program_t& program,
+                                const boost::filesystem::path& output_dir,
+                                const std::string& optimization_level,
+                                const std::string& compiler_options,
+                                const boost::optional<boost::filesystem::path>& cache_dir)
+{
+   if (cache_dir)
+      return instrumentation_cache(*cache_dir).instrument(program, optimization_level,
+                                                          compiler_options);
+   return scheduler::instrument(program, output_dir / "instrumented", optimization_level,
+                                compiler_options);
+}
+
+//--------------------------------------------------------------------------------------------------
+
 } // end namespace detail
 
 //--------------------------------------------------------------------------------------------------
@@ -67,6 +116,13 @@ void ExplorationStatistics::increase_nr_explorations()
 
 //--------------------------------------------------------------------------------------------------
 
+void ExplorationStatistics::increase_nr_explorations(const unsigned int nr)
+{
+   mNrExplorations += nr;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 double ExplorationStatistics::time_cpu() const
 {
    return mTimeCpu;
@@ -74,6 +130,13 @@ double ExplorationStatistics::time_cpu() const
 
 //--------------------------------------------------------------------------------------------------
 
+double ExplorationStatistics::time_wall() const
+{
+   return mTimeWall;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void ExplorationStatistics::start_clock()
 {
    mTimeCpuStart = std::clock();
@@ -84,8 +147,16 @@ void ExplorationStatistics::start_clock()
 
 void ExplorationStatistics::stop_clock()
 {
-   mTimeCpu = ((std::clock() - mTimeCpuStart) / (double)CLOCKS_PER_SEC);
-   mTimeWall = std::chrono::duration<double>(wall_clock_t::now() - mTimeWallStart).count();
+   mTimeCpu += ((std::clock() - mTimeCpuStart) / (double)CLOCKS_PER_SEC);
+   mTimeWall += std::chrono::duration<double>(wall_clock_t::now() - mTimeWallStart).count();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void ExplorationStatistics::add_time(const double cpu, const double wall)
+{
+   mTimeCpu += cpu;
+   mTimeWall += wall;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -110,6 +181,11 @@ ExplorationBase::ExplorationBase(const scheduler::program_t& program,
 , mStatistics()
 , mDone(false)
 , mLogSchedules()
+, m_settings()
+, mIterationHook()
+, mExhaustedBudget()
+, mLastCheckpoint()
+, mCheckpointWriter()
 {
 }
 
@@ -122,6 +198,30 @@ ExplorationStatistics ExplorationBase::statistics() const
 
 //--------------------------------------------------------------------------------------------------
 
+bool ExplorationBase::within_budget()
+{
+   if (m_settings.deadline && std::chrono::steady_clock::now() >= *m_settings.deadline)
+   {
+      mExhaustedBudget = std::string("time");
+   }
+   else if (m_settings.memory_budget &&
+            detail::peak_resident_set_size() > *m_settings.memory_budget * 1024)
+   {
+      mExhaustedBudget = std::string("memory");
+   }
+   return !mExhaustedBudget;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool ExplorationBase::checkpoint_due() const
+{
+   return m_settings.checkpoint_interval &&
+          std::chrono::steady_clock::now() - mLastCheckpoint >= *m_settings.checkpoint_interval;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 const std::string ExplorationBase::name = "Exploration";
 
 //--------------------------------------------------------------------------------------------------
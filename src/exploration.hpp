@@ -1,5 +1,6 @@
 #pragma once
 
+#include "checkpoint.hpp"
 #include "color_output.hpp"
 #include "container_output.hpp"
 #include "debug.hpp"
@@ -13,6 +14,9 @@
 #include "transition.hpp"
 #include "utils_io.hpp"
 #include <chrono>
+#include <functional>
+#include <future>
+#include <sstream>
 
 #include <boost/filesystem.hpp>
 
@@ -38,6 +42,28 @@ program_model::Execution replay(const scheduler::program_t& program,
 
 void move_records(unsigned int nr, const boost::filesystem::path& source_dir);
 
+//--------------------------------------------------------------------------------------------------
+
+
+/// @brief Returns the peak resident set size in KiB of this process plus that of its largest
+/// terminated child, i.e. of the largest replay so far.
+
+std::size_t peak_resident_set_size();
+
+/// @brief Writes checkpoint to file from a background thread, through a temporary file that
+/// replaces file once complete.
+
+std::future<void> write_checkpoint(std::string checkpoint, const boost::filesystem::path& file);
+
+/// @brief Returns the instrumented executable of program from the instrumentation_cache in
+/// cache_dir if it is set, and otherwise instruments program into output_dir/instrumented.
+
+scheduler::program_t instrument(const scheduler::program_t& program,
+                                const boost::filesystem::path& output_dir,
+                                const std::string& optimization_level,
+                                const std::string& compiler_options,
+                                const boost::optional<boost::filesystem::path>& cache_dir);
+
 } // end namespace detail
 
 //--------------------------------------------------------------------------------------------------
@@ -48,6 +74,22 @@ struct Settings
    bool keep_records = false;
    bool keep_logs = false;
    boost::optional<scheduler::timeout_t> timeout = boost::none;
+   /// @brief No new execution is started after the deadline.
+   boost::optional<std::chrono::steady_clock::time_point> deadline = boost::none;
+   /// @brief No new execution is started once detail::peak_resident_set_size exceeds this many
+   /// MiB.
+   boost::optional<std::size_t> memory_budget = boost::none;
+   /// @brief A checkpoint is written to output_dir/checkpoint.bin at most every interval, and
+   /// when the exploration stops before it is done.
+   boost::optional<std::chrono::seconds> checkpoint_interval = boost::none;
+   /// @brief Without a checkpoint_interval, a checkpoint is still written when a budget stops
+   /// the exploration before it is done.
+   bool checkpoint_on_budget = false;
+   /// @brief The directory of the instrumentation_cache that is shared between explorations.
+   boost::optional<boost::filesystem::path> instrumentation_cache = boost::none;
+   /// @brief dpor collapses the Transitions on thread-local objects out of its backtrack
+   /// analysis.
+   bool thread_local_objects = false;
 
 }; // end struct Settings
 
@@ -61,10 +103,16 @@ public:
 
    unsigned int nr_explorations() const;
    void increase_nr_explorations();
+   void increase_nr_explorations(const unsigned int nr);
 
    double time_cpu() const;
+   double time_wall() const;
    void start_clock();
+   /// @brief Adds the time since start_clock to time_cpu and time_wall.
    void stop_clock();
+   /// @brief Adds the time of an earlier part of the same exploration, such as the part before
+   /// the checkpoint it is resumed from.
+   void add_time(const double cpu, const double wall);
 
    void dump(const boost::filesystem::path& filename) const;
 
@@ -91,6 +139,19 @@ public:
 
    void set_settings(const Settings& settings) { m_settings = settings; }
 
+   unsigned int max_nr_explorations() const { return mMaxNrExplorations; }
+
+   /// @brief Changes the number of explorations after which the exploration stops, e.g. when
+   /// part of the budget is handed to another explorer.
+   void set_max_nr_explorations(const unsigned int max) { mMaxNrExplorations = max; }
+
+   /// @brief Returns the budget of m_settings that stopped the exploration, if any.
+   const boost::optional<std::string>& exhausted_budget() const { return mExhaustedBudget; }
+
+   /// @brief Sets a function that is called after every exploration that yields a new schedule,
+   /// i.e. at the point where the exploration can be split.
+   void set_iteration_hook(const std::function<void()>& hook) { mIterationHook = hook; }
+
 protected:
    using execution = program_model::Execution;
    using transition = typename execution::transition_t;
@@ -103,6 +164,17 @@ protected:
    bool mDone;
    std::ofstream mLogSchedules;
    Settings m_settings;
+   std::function<void()> mIterationHook;
+   boost::optional<std::string> mExhaustedBudget;
+   std::chrono::steady_clock::time_point mLastCheckpoint;
+   std::future<void> mCheckpointWriter;
+
+   /// @brief Returns true iff the deadline or the memory budget of m_settings is exceeded, in
+   /// which case the exceeded budget is recorded in mExhaustedBudget.
+   bool within_budget();
+
+   /// @brief Returns true iff m_settings.checkpoint_interval passed since the last checkpoint.
+   bool checkpoint_due() const;
 
    static const std::string name;
    static std::string outputname();
@@ -126,6 +198,7 @@ public:
                         Args... args)
    : ExplorationBase(program, max_nr_explorations)
    , mMode(mExecution, std::forward<Args>(args)...)
+   , mSplittable(false)
    {
    }
 
@@ -141,16 +214,157 @@ public:
          boost::filesystem::remove_all(output_dir);
       boost::filesystem::create_directories(output_dir);
 
-      const auto instrumented_executable = scheduler::instrument(
-         mProgram, output_dir / "instrumented", optimization_level, compiler_options);
+      const auto instrumented_executable = detail::instrument(
+         mProgram, output_dir, optimization_level, compiler_options,
+         m_settings.instrumentation_cache);
 
+      explore(instrumented_executable, s, output_dir);
+      close(output_dir);
+   }
+
+   /// @brief Continues the exploration of which Exploration<Mode>::close or the periodic
+   /// checkpointing wrote the state to checkpoint_file, in the output_dir of that exploration,
+   /// and explores the same executions as the exploration would have without stopping.
+
+   void resume(const boost::filesystem::path& checkpoint_file,
+               const std::string& optimization_level = "0",
+               const std::string& compiler_options = "",
+               const boost::filesystem::path& output_dir = "./statespace_explorer_output")
+   {
+      const auto instrumented_executable = detail::instrument(
+         mProgram, output_dir, optimization_level, compiler_options,
+         m_settings.instrumentation_cache);
+
+      restore(instrumented_executable, checkpoint_file, output_dir);
+      close(output_dir);
+   }
+
+   /// @brief Traverses the subtree of the exploration tree rooted at schedule s of an already
+   /// instrumented program, without backtracking into the first floor levels of s.
+
+   void explore(const scheduler::program_t& instrumented_executable,
+                const scheduler::schedule_t& s, const boost::filesystem::path& output_dir,
+                const unsigned int floor = 0)
+   {
       // Open scheduler log file here once, opening in append mode is costly
-      mLogSchedules.open((output_dir / "schedules.txt").string());
+      mLogSchedules.open((output_dir / "schedules.txt").string(), std::ofstream::app);
       scheduler::write_settings(mMode.scheduler_settings());
+      mMode.set_floor(floor);
       mSchedule = s;
-      int from = 1;
+      mSplittable = false;
+      explore_from(instrumented_executable, output_dir, 1);
+   }
+
+   /// @brief Restores the state of an already instrumented program's exploration from
+   /// checkpoint_file and continues it.
+   /// @details Mode's state along the branch that was current at the checkpoint is rebuilt by
+   /// replaying the branch and calling Mode::update_state for its Transitions, after which
+   /// Mode::restore overwrites what later explorations changed, such as the done sets and the
+   /// backtrack sets. output_dir/schedules.txt is truncated to its size at the checkpoint, and the
+   /// number of explorations and the time up to the checkpoint are added to the statistics.
+   /// @throws std::runtime_error if checkpoint_file was not written by an Exploration<Mode>.
+
+   void restore(const scheduler::program_t& instrumented_executable,
+                const boost::filesystem::path& checkpoint_file,
+                const boost::filesystem::path& output_dir)
+   {
+      std::ifstream is(checkpoint_file.string(), std::ios::binary);
+      if (!is)
+         throw std::runtime_error("Could not open " + checkpoint_file.string());
+      if (checkpoint::read_string(is) != full_name())
+         throw std::runtime_error(checkpoint_file.string() + " was not written by " + full_name());
+      const auto nr_explorations = checkpoint::read<std::uint32_t>(is);
+      const auto time_cpu = checkpoint::read<double>(is);
+      const auto time_wall = checkpoint::read<double>(is);
+      const auto log_size = checkpoint::read<std::uint64_t>(is);
+      const auto prefix_size = checkpoint::read<std::uint64_t>(is);
+      mSchedule = checkpoint::read_tids<scheduler::schedule_t>(is);
+
+      scheduler::write_settings(mMode.scheduler_settings());
+      mMode.write_scheduler_files();
+      mExecution = detail::replay(instrumented_executable, mSchedule, output_dir / "records",
+                                  m_settings.timeout);
+      mMode.reset();
+      while (mExecution.size() > prefix_size)
+         mExecution.pop_last();
+      for (unsigned int index = 1; index <= mExecution.size(); ++index)
+         mMode.update_state(mExecution, mExecution[index]);
+      mMode.restore(is);
+      mSplittable = true;
+      mStatistics.increase_nr_explorations(nr_explorations);
+      mStatistics.add_time(time_cpu, time_wall);
+
+      boost::filesystem::resize_file(output_dir / "schedules.txt", log_size);
+      mLogSchedules.open((output_dir / "schedules.txt").string(), std::ofstream::app);
+      explore_from(instrumented_executable, output_dir, prefix_size + 1);
+   }
+
+   /// @brief Gives up the unexplored alternatives at the shallowest level of the current branch
+   /// that has any and returns them as schedules. Before the first replay, Mode has no branch to
+   /// split and nothing is given up.
+   /// @note Only to be called from the iteration hook, i.e. between two replays.
+
+   std::vector<scheduler::schedule_t> split()
+   {
+      if (!mSplittable)
+         return {};
+      return mMode.split(mExecution, mSchedule);
+   }
+
+   Mode& mode() { return mMode; }
+   const scheduler::schedule_t& schedule() const { return mSchedule; }
+
+   /// @brief Stops the clock, dumps the statistics of this exploration to output_dir and closes 
+   /// the schedule log.
+   /// @details With checkpointing enabled, or with checkpoint_on_budget if a budget stopped it, an
+   /// exploration that is not done and explored at least one program run writes a final
+   /// checkpoint, from which it can be resumed with a larger budget. If a budget stopped the
+   /// exploration, the unexplored part of the exploration tree
+   /// is appended to output_dir/frontier.txt, as schedules that each root a subtree to be
+   /// explored with a floor of its length (as the jobs of parallel::run are). If no program run
+   /// was explored, the frontier is the initial schedule.
+   /// @note The frontier lists schedules only. For Modes that prune with state of their own, such
+   /// as dpor's backtrack and sleep sets, exploring its schedules is not equivalent to continuing
+   /// the exploration (for dpor, a subtree explored without the sleep sets of its prefix explores
+   /// executions already covered elsewhere); resume from output_dir/checkpoint.bin instead.
+
+   void close(const boost::filesystem::path& output_dir)
+   {
+      if (mCheckpointWriter.valid())
+         mCheckpointWriter.get();
+      const bool checkpoint =
+         m_settings.checkpoint_interval || (m_settings.checkpoint_on_budget && mExhaustedBudget);
+      if (checkpoint && !mDone && mStatistics.nr_explorations() > 0)
+      {
+         write_checkpoint(output_dir);
+         mCheckpointWriter.get();
+      }
+      mStatistics.stop_clock();
+      const boost::filesystem::path statistics_file = output_dir / "statistics.txt";
+      mStatistics.dump(statistics_file);
+      mLogSchedules.close();
+      mMode.close(statistics_file.string());
+      if (mExhaustedBudget)
+      {
+         utils::io::write_to_file(statistics_file.string(),
+                                  "exhausted_budget\t" + *mExhaustedBudget + "\n", std::ios::app);
+         dump_frontier(output_dir / "frontier.txt");
+      }
+   }
+
+private:
+   Mode mMode;
+
+   /// @brief true iff mSchedule was returned by Mode::new_schedule (or restored from a
+   /// checkpoint) for mExecution, so that Mode::split can split it.
+   bool mSplittable;
+
+   void explore_from(const scheduler::program_t& instrumented_executable,
+                     const boost::filesystem::path& output_dir, unsigned int from)
+   {
       mStatistics.start_clock();
-      while (!mDone && mStatistics.nr_explorations() < mMaxNrExplorations)
+      mLastCheckpoint = std::chrono::steady_clock::now();
+      while (!mDone && mStatistics.nr_explorations() < mMaxNrExplorations && within_budget())
       {
          mMode.write_scheduler_files();
          mExecution = detail::replay(instrumented_executable, mSchedule, output_dir / "records",
@@ -170,7 +384,14 @@ public:
                mDone = true;
                break;
             }
-            from = mSchedule.size();
+            mSplittable = true;
+            // new_schedule rolled mExecution back to the retained prefix, which the new schedule
+            // may extend by more than one Transition
+            from = mExecution.size() + 1;
+            if (mIterationHook)
+               mIterationHook();
+            if (checkpoint_due())
+               write_checkpoint(output_dir);
          }
          else
          {
@@ -178,11 +399,8 @@ public:
             break;
          }
       }
-      close(output_dir);
    }
 
-private:
-   Mode mMode;
 
    void update_statistics()
    {
@@ -190,8 +408,10 @@ private:
       mMode.update_statistics(mExecution);
    }
 
-   /// @brief Loops through the Transitions of mExecution and lets Mode restore and update its 
-   /// internal state.
+   /// @brief Lets Mode update its internal state with the Transitions of mExecution from index 
+   /// from onwards.
+   /// @note The Transitions before from are those of the retained prefix of the previous 
+   /// exploration, for which Mode's state (including its happens-before frontier) is still valid.
 
    void update_state(unsigned int from)
    {
@@ -200,28 +420,12 @@ private:
       mLogSchedules << mSchedule << std::endl;
 
       DEBUGF(outputname(), "UPDATE_STATE", "from=" << from, "\n");
-      for (auto& t : mExecution)
+      for (auto index = from; index <= mExecution.size(); ++index)
       {
-         if (t.index() < from)
-         {
-            mMode.restore_state(t);
-         }
-         else
-         {
-            mMode.update_state(mExecution, t);
-         }
+         mMode.update_state(mExecution, mExecution[index]);
       }
    }
 
-   void close(const boost::filesystem::path& output_dir)
-   {
-      mStatistics.stop_clock();
-      const boost::filesystem::path statistics_file = output_dir / "statistics.txt";
-      mStatistics.dump(statistics_file);
-      mLogSchedules.close();
-      mMode.close(statistics_file.string());
-   }
-
    template <typename OutStream>
    void dump_state(OutStream& os, const transition& t) const
    {
@@ -246,6 +450,53 @@ private:
 
    void dump_state(const unsigned int i) const { mMode.dump_state(i); }
 
+   /// @brief Serializes the state of this exploration for restore and hands it to a background
+   /// thread that writes it to output_dir/checkpoint.bin. The serialized state is that of the
+   /// per-level sets of Mode, so writing it is cheap compared to a replay. While a previous
+   /// checkpoint is still being written, no new one is started, so replays never wait for it.
+   /// @pre Called between new_schedule and replay, i.e. mSchedule is the next schedule.
+
+   void write_checkpoint(const boost::filesystem::path& output_dir)
+   {
+      if (mCheckpointWriter.valid() &&
+          mCheckpointWriter.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+         return;
+      }
+      if (mCheckpointWriter.valid())
+         mCheckpointWriter.get();
+      mLogSchedules.flush();
+      std::ostringstream os;
+      checkpoint::write_string(os, full_name());
+      checkpoint::write<std::uint32_t>(os, mStatistics.nr_explorations());
+      // The clock keeps running, the checkpoint gets the time up to now
+      auto statistics = mStatistics;
+      statistics.stop_clock();
+      checkpoint::write<double>(os, statistics.time_cpu());
+      checkpoint::write<double>(os, statistics.time_wall());
+      checkpoint::write<std::uint64_t>(os,
+                                       boost::filesystem::file_size(output_dir / "schedules.txt"));
+      checkpoint::write<std::uint64_t>(os, mExecution.size());
+      checkpoint::write_tids(os, mSchedule);
+      mMode.save(os);
+      mCheckpointWriter = detail::write_checkpoint(os.str(), output_dir / "checkpoint.bin");
+      mLastCheckpoint = std::chrono::steady_clock::now();
+   }
+
+   /// @brief Appends the subtrees given up by split and the subtree of mSchedule to frontier_file.
+   /// @pre Called between two replays, i.e. mSchedule is the next schedule.
+
+   void dump_frontier(const boost::filesystem::path& frontier_file)
+   {
+      std::ofstream ofs(frontier_file.string(), std::ofstream::app);
+      for (auto jobs = split(); !jobs.empty(); jobs = split())
+      {
+         for (const auto& job : jobs)
+            ofs << job << std::endl;
+      }
+      ofs << mSchedule << std::endl;
+   }
+
    static std::string full_name()
    {
       std::string full_name = name;
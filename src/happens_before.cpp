@@ -37,13 +37,21 @@ void HappensBeforeBase::thread_transitive_reduction(const index_t i,
 
 //--------------------------------------------------------------------------------------------------
 
-VectorClock::indices_t HappensBeforeBase::thread_transitive_relation(
-   const index_t i, const index_t ifrom, const program_model::Thread::tid_t tid) const
+tid_set HappensBeforeBase::thread_transitive_relation(const index_t i, const index_t ifrom,
+                                                      const program_model::Thread::tid_t tid) const
 {
    /// @pre frontier_valid_for(i)
    assert(frontier_valid_for(i));
-   return indices_such_that(previous_by(tid),
-                            [&ifrom](const auto& value) { return value > ifrom; });
+   const clock_view clock = previous_by(tid);
+   tid_set relation{};
+   for (std::size_t tid_j = 0; tid_j < clock.size(); ++tid_j)
+   {
+      if (clock[tid_j] > ifrom)
+      {
+         relation.insert(tid_j);
+      }
+   }
+   return relation;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -74,8 +82,8 @@ VectorClock::values_t HappensBeforeBase::front(const VectorClock::indices_t& sub
       VectorClock last_seen(mE.nr_threads());
       for (const auto& i : subseq)
       {
-         const auto tid = boost::apply_visitor(program_model::get_tid(), mE[i].instr());
-         const VectorClock& C = (*this)[i];
+         const auto tid = mRecords[i].tid;
+         const clock_view C = (*this)[i];
          if (first_seen[tid] == 0)
          {
             auto seen_before = utils::algo::find_if_with_index(
@@ -110,10 +118,29 @@ VectorClock::values_t HappensBeforeBase::front(const VectorClock::indices_t& sub
 
 //--------------------------------------------------------------------------------------------------
 
-void HappensBeforeBase::pop_back()
+program_model::Thread::tid_t HappensBeforeBase::pop_back()
 {
+   /// @pre frontier_valid_for(mHB.size()-1)
+   assert(frontier_valid_for(mHB.size() - 1));
+   const index_t last = mHB.size() - 1;
+   // mE no longer contains the popped Transition, but its thread's frontier refers to it
+   program_model::Thread::tid_t tid = 0;
+   while (mFrontier[tid][tid] != last)
+   {
+      ++tid;
+   }
+   const auto previous = mHB[last][tid];
+   if (previous > 0)
+      mFrontier[tid].assign(mHB[previous]);
+   else
+      std::fill(mFrontier[tid].begin(), mFrontier[tid].end(), 0);
+   mFrontier[tid][tid] = previous;
    mHB.pop_back();
-   mIndex = 0;
+   mRecords.pop_back();
+   --mIndex;
+   /// @post frontier_valid_for(mHB.size()-1)
+   assert(frontier_valid_for(mHB.size() - 1));
+   return tid;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -121,61 +148,55 @@ void HappensBeforeBase::pop_back()
 void HappensBeforeBase::reset()
 {
    const auto size = mE.nr_threads();
-   
-   // reset the frontier
-   mFrontier = frontier_t(size, VectorClock(size));
-   mIndex = 0;
-   
+   if (size == mFrontier.size())
+      return;
+
    // grow / narrow down the VectorClocks
    assert(mHB.size() <= mE.size()+1);
-   std::for_each(mHB.begin(), mHB.end(), [size](auto& clock) { clock = VectorClock{clock, size}; });
-}
-
-//--------------------------------------------------------------------------------------------------
-
-void HappensBeforeBase::restore(const index_t i)
-{
-   /// @pre not_restored() && frontier_valid_for(index-1) (impl. defined_on_prefix(i-1)).
-   assert(not_restored() && frontier_valid_for(i - 1));
-   update_frontier(mE[i], mHB[i]);
-   /// @post defined_on_prefix(i) && frontier_valid_for(i) (impl. invariant1)
-   assert(defined_on_prefix(i) && frontier_valid_for(i));
+   mHB.set_width(size);
+   frontier_t frontier(size, VectorClock(size));
+   for (std::size_t tid = 0; tid < std::min<std::size_t>(size, mFrontier.size()); ++tid)
+   {
+      frontier[tid] = VectorClock{mFrontier[tid], size};
+   }
+   mFrontier = frontier;
 }
 
 //--------------------------------------------------------------------------------------------------
 
-program_model::Tids HappensBeforeBase::tids(const VectorClock::values_t& indices) const
+tid_set HappensBeforeBase::tids(const VectorClock::values_t& indices) const
 {
-   program_model::Tids T{};
-   std::transform(indices.begin(), indices.end(), std::inserter(T, T.end()), [this](const auto& i) {
-      return boost::apply_visitor(program_model::get_tid(), mE[i].instr());
-   });
+   tid_set T{};
+   for (const auto& i : indices)
+   {
+      T.insert(mRecords[i].tid);
+   }
    return T;
 }
 
 //--------------------------------------------------------------------------------------------------
 
-const VectorClock& HappensBeforeBase::operator[](const index_t i) const
+clock_view HappensBeforeBase::operator[](const index_t i) const
 {
    return mHB[i];
 }
 
 //--------------------------------------------------------------------------------------------------
 
-void HappensBeforeBase::update_frontier(const transition_t& t, const VectorClock& clock)
+void HappensBeforeBase::update_frontier(const index_t i, const clock_view& clock)
 {
-   const auto tid = boost::apply_visitor(program_model::get_tid(), t.instr());
-   mFrontier[tid] = clock;
-   mFrontier[tid][tid] = t.index();
+   const auto tid = mRecords[i].tid;
+   mFrontier[tid].assign(clock);
+   mFrontier[tid][tid] = i;
    ++mIndex;
 }
 
 //--------------------------------------------------------------------------------------------------
 
-VectorClock::indices_t HappensBeforeBase::covering(const index_t i, const instruction_t& instr,
+VectorClock::indices_t HappensBeforeBase::covering(const index_t i, const transition_record& instr,
                                                    VectorClock C) const
 {
-   const auto tid = boost::apply_visitor(program_model::get_tid(), instr);
+   const auto tid = instr.tid;
    thread_transitive_reduction(i, tid, C);
    C[tid] = 0; // exclude instr.tid-dependencies
    VectorClock::indices_t Covering{};
@@ -185,8 +206,7 @@ VectorClock::indices_t HappensBeforeBase::covering(const index_t i, const instru
    {
       Covering.insert(j);
       transitive_reduction(j, C);
-      const auto tid_j = boost::apply_visitor(program_model::get_tid(), mE[j].instr());
-      C[tid_j] = 0;
+      C[mRecords[j].tid] = 0;
    }
    DEBUGF("\t" << outputname(), "covering", "[" << i << "], " << instr, " = " << Covering << "\n");
    return Covering;
@@ -194,23 +214,21 @@ VectorClock::indices_t HappensBeforeBase::covering(const index_t i, const instru
 
 //--------------------------------------------------------------------------------------------------
 
-bool HappensBeforeBase::restored() const
-{
-   return mIndex == mHB.size() - 1;
-}
-
-//--------------------------------------------------------------------------------------------------
-
-bool HappensBeforeBase::not_restored() const
+bool HappensBeforeBase::frontier_valid_for(const index_t i) const
 {
-   return mIndex < mHB.size() - 1;
+   return mIndex == i;
 }
 
 //--------------------------------------------------------------------------------------------------
 
-bool HappensBeforeBase::frontier_valid_for(const index_t i) const
+bool HappensBeforeBase::thread_local_to(const transition_record& instr) const
 {
-   return mIndex == i;
+   if (!mFilterThreadLocal)
+   {
+      return false;
+   }
+   const tid_set& threads = mOperands.statistics(instr.operand).threads;
+   return threads.empty() || (threads.size() == 1 && threads.count(instr.tid) == 1);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -245,18 +263,17 @@ std::string HappensBeforeBase::outputname()
 
 //--------------------------------------------------------------------------------------------------
 
-bool HappensBeforeBase::happens_before(const index_t i1, const VectorClock& clock2) const
+bool HappensBeforeBase::happens_before(const index_t i1, const clock_view& clock2) const
 {
-   const auto tid = boost::apply_visitor(program_model::get_tid(), mE[i1].instr());
-   return clock2[tid] >= i1;
+   return clock2[mRecords[i1].tid] >= i1;
 }
 
 //--------------------------------------------------------------------------------------------------
 
-const VectorClock& HappensBeforeBase::previous_by(const program_model::Thread::tid_t& tid) const
+clock_view HappensBeforeBase::previous_by(const program_model::Thread::tid_t& tid) const
 {
-   const auto tid_index = boost::apply_visitor(program_model::get_tid(), mE[mIndex].instr());
-   return tid_index == tid ? mHB[mHB[mIndex][tid]] : mFrontier[tid];
+   const auto tid_index = mRecords[mIndex].tid;
+   return tid_index == tid ? mHB[mHB[mIndex][tid]] : clock_view(mFrontier[tid]);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "access_index.hpp"
+#include "clock_arena.hpp"
+#include "tid_set.hpp"
+#include "transition_record.hpp"
+#include "tree_clock.hpp"
 #include "vector_clock.hpp"
 
 #include "execution.hpp"
@@ -28,7 +33,8 @@ using transition_t = execution_t::transition_t;
 using instruction_t = transition_t::instruction_t;
 
 /// @brief Creates the HappensBefore edges to the given instruction after pre(execution,index),
-/// defined as max{clock(j) | j in [1..index-1) and dependent(execution[j], instruction)}.
+/// defined as max{clock(j) | j in [1..index-1) and dependent(execution[j], instruction)}, where
+/// records[j] is decoded from execution[j].instr().
 /// @note To see that it is not necessary to start from frntier(index, instruction.tid):
 /// let last_seen_tid = frontier(index, instruction.tid)[tid].
 /// for every j in dom(execution) | j > last_seen_tid it holds that
@@ -40,28 +46,30 @@ using instruction_t = transition_t::instruction_t;
 /// frontier[t.instr.tid][t.instr.tid] = index.
 
 template <typename Dependence>
-VectorClock create_clock(const execution_t& execution,
-                         const std::vector<VectorClock> happens_before_relation,
-                         const execution_t::index_t index, const instruction_t& instruction)
+VectorClock create_clock(const std::vector<transition_record>& records,
+                         const clock_arena& happens_before_relation,
+                         const execution_t::index_t index, const transition_record& instruction,
+                         operand_interner& operands)
 {
    assert(happens_before_relation.size() >= index - 1);
 
-   VectorClock clock(execution.nr_threads());
+   VectorClock clock(happens_before_relation.width());
    DEBUGF(text_color("HappensBefore", utils::io::Color::YELLOW), "create_clock",
           "pre(execution, " << index << ")." << instruction, "\n");
    DEBUG(" = MAX( " << clock);
 
    int min = min_element(clock);
-   const auto tid = boost::apply_visitor(program_model::get_tid(), instruction);
 
    for (int j = index - 1; j > min; --j)
    {
-      const instruction_t& instruction_j = execution[j].instr();
-      const auto tid_j = boost::apply_visitor(program_model::get_tid(), instruction_j);
+      const transition_record& instruction_j = records[j];
+      const auto tid_j = instruction_j.tid;
 
       // j -!>_pre(execution,index) instruction.tid
       if (j > clock[tid_j] && Dependence::dependent(instruction_j, instruction))
       {
+         if (tid_j != instruction.tid)
+            operands.record_join(instruction.operand);
          clock.max(happens_before_relation[j]);
          clock[tid_j] = j;
          min = min_element(clock);
@@ -72,6 +80,125 @@ VectorClock create_clock(const execution_t& execution,
    return clock;
 }
 
+//--------------------------------------------------------------------------------------------------
+
+using frontier_t = datastructures::fixed_size_vector<VectorClock>;
+
+/// @brief Keeps a clock_t for the last Transition of every Thread, i.e. the reflexive clocks of
+/// the frontier, into which the clocks of new Transitions are joined in place.
+/// @details A join with the clock of a Thread's last Transition uses the kept clock_t, a join
+/// with the clock of any earlier Transition uses its row in the relation.
+
+template <typename clock_t>
+class thread_clocks
+{
+public:
+   using tid_t = program_model::Thread::tid_t;
+   using index_t = execution_t::index_t;
+
+   explicit thread_clocks(const frontier_t& frontier)
+   {
+      reset(frontier);
+   }
+
+   /// @brief Rebuilds all clocks from the frontier if the number of threads changed.
+
+   void reset(const frontier_t& frontier)
+   {
+      if (mClocks.size() == frontier.size())
+         return;
+      mClocks.clear();
+      for (tid_t tid = 0; tid < static_cast<tid_t>(frontier.size()); ++tid)
+      {
+         mClocks.emplace_back(frontier[tid], tid);
+      }
+   }
+
+   /// @brief Rebuilds the clock of tid from its rolled back frontier.
+
+   void pop_back(const frontier_t& frontier, const tid_t tid)
+   {
+      mClocks[tid].assign(frontier[tid]);
+   }
+
+   /// @brief Advances the clock of tid to index and returns it, such that the clock of the
+   /// Transition at index is joined into it in place.
+
+   clock_t& advance(const frontier_t&, const tid_t tid, const index_t index)
+   {
+      mClocks[tid].advance(index);
+      return mClocks[tid];
+   }
+
+   /// @brief Joins the reflexive clock of Transition j by tid_j into clock.
+   /// @returns false iff clock already knew j, and hence the clock of j.
+
+   bool join(clock_t& clock, const frontier_t& frontier, const clock_arena& relation,
+             const index_t j, const tid_t tid_j) const
+   {
+      const auto value = static_cast<VectorClock::value_t>(j);
+      if (clock[tid_j] >= value)
+         return false;
+      if (frontier[tid_j][tid_j] == value)
+      {
+         clock.join(mClocks[tid_j]);
+      }
+      else
+      {
+         clock.join(relation[j]);
+         clock.join(tid_j, value);
+      }
+      return true;
+   }
+
+private:
+   std::vector<clock_t> mClocks;
+
+}; // end class template thread_clocks
+
+/// @brief VectorClocks are joined directly from the frontier and the relation, into one clock
+/// that is reused for every Transition.
+
+template <>
+class thread_clocks<VectorClock>
+{
+public:
+   using tid_t = program_model::Thread::tid_t;
+   using index_t = execution_t::index_t;
+
+   explicit thread_clocks(const frontier_t& frontier)
+   : mClock(frontier.size())
+   {
+   }
+
+   void reset(const frontier_t&) {}
+   void pop_back(const frontier_t&, const tid_t) {}
+
+   VectorClock& advance(const frontier_t& frontier, const tid_t tid, const index_t index)
+   {
+      if (mClock.size() != frontier.size())
+         mClock = VectorClock(frontier.size());
+      mClock.assign(frontier[tid]);
+      mClock[tid] = index;
+      return mClock;
+   }
+
+   bool join(VectorClock& clock, const frontier_t&, const clock_arena& relation, const index_t j,
+             const tid_t tid_j) const
+   {
+      const auto value = static_cast<VectorClock::value_t>(j);
+      if (clock[tid_j] >= value)
+         return false;
+      clock.max(relation[j]);
+      clock[tid_j] = value;
+      return true;
+   }
+
+private:
+   VectorClock mClock;
+
+}; // end class thread_clocks<VectorClock>
+
 } // namespace detail
 
 //--------------------------------------------------------------------------------------------------
@@ -85,14 +212,17 @@ public:
    using execution_t = program_model::Execution;
    using transition_t = execution_t::transition_t;
    using instruction_t = transition_t::instruction_t;
-   using relation = std::vector<VectorClock>;
+   using relation = clock_arena;
    using index_t = typename execution_t::index_t;
 
    explicit HappensBeforeBase(const execution_t& E)
    : mE(E)
-   , mHB({VectorClock(mE.nr_threads())})
+   , mHB(mE.nr_threads(), 1)
    , mFrontier(mE.nr_threads(), VectorClock(mE.nr_threads()))
    , mIndex(0)
+   , mRecords(1, transition_record{-1, operation_kind::other, 0})
+   , mOperands()
+   , mFilterThreadLocal(false)
    {
    }
 
@@ -116,8 +246,8 @@ public:
    /// @details The function's parameter ifrom restricts the relation to vertices with index greater
    /// than ifrom.
 
-   VectorClock::indices_t thread_transitive_relation(const index_t i, const index_t ifrom,
-                                                     const program_model::Thread::tid_t tid) const;
+   tid_set thread_transitive_relation(const index_t i, const index_t ifrom,
+                                      const program_model::Thread::tid_t tid) const;
 
    /// @brief Returns <code>{ i1 < j < i2 | !hb(mE[i1],mE[j]) }</code>.
 
@@ -128,27 +258,42 @@ public:
 
    VectorClock::values_t front(const VectorClock::indices_t& subseq) const;
 
-   /// @brief Pops the last element of mHB and sets mIndex to 0 (i.e. mFrontier is no longer valid,
-   /// because mFrontier is not reset).
+   /// @brief Pops the last element of mHB and rolls mFrontier back to the previous Transition of
+   /// the popped Transition's thread, so that mFrontier stays valid for the retained prefix.
+   /// @returns The thread of the popped Transition.
 
-   void pop_back();
+   program_model::Thread::tid_t pop_back();
 
    /// @brief Reset this HappensBeforeBase to the potentially updated underlying execution mE.
+   /// @note As a replay preserves the prefix of mE on which mHB is defined, mHB and mFrontier
+   /// are kept and only resized if the number of threads in mE changed.
 
    void reset();
 
-   /// @brief Restores mFrontier to be valid for mE[i] using mHB.
+   tid_set tids(const VectorClock::values_t& indices) const;
+
+   /// @brief Returns the operands seen so far, with their statistics.
 
-   void restore(const index_t i);
+   const operand_interner& operands() const { return mOperands; }
 
-   program_model::Tids tids(const VectorClock::values_t& indices) const;
+   /// @brief Enables or disables the collapsing of Transitions on thread-local operands out of the
+   /// backtrack analysis.
+   /// @details An operand is thread-local to a thread if no other thread accessed it in any
+   /// exploration so far. As the only dependencies between Transitions of different threads are
+   /// through a shared operand, a query for an instruction on an operand that is thread-local to
+   /// its thread has no dependent Transition of another thread and is answered without building a
+   /// clock. Once a second thread accesses the operand, it is promoted to shared in update, before
+   /// the Transition of that thread is analysed, such that the race is found from that Transition.
+
+   void filter_thread_local(const bool filter) { mFilterThreadLocal = filter; }
 
 protected:
    /// @brief Reference to execution_t object to which this HappensBefore
    /// relation is attached.
    const execution_t& mE;
 
-   /// @brief The actual HappensBefore relation.
+   /// @brief The actual HappensBefore relation, i.e. the clock of every Transition in one
+   /// contiguous arena.
    relation mHB;
 
    /// @brief Caching the edges of the last Transition by each program_model::Thread in pre+(mE,
@@ -158,13 +303,31 @@ protected:
    /// @brief Index in mE with which mFrontier is corresponding.
    unsigned int mIndex;
 
+   /// @brief mRecords[i] is decoded from mE[i].instr() for every Transition on which mHB is
+   /// defined. Like mHB, mRecords starts with a placeholder for index 0.
+   std::vector<transition_record> mRecords;
+
+   /// @brief Interns the operands of mRecords and of the instructions queried, and counts their
+   /// accesses and dependencies. Interning the operand of a queried instruction does not change
+   /// the relation. As HappensBeforeBase outlives the explorations, the ids are stable across them.
+   mutable operand_interner mOperands;
+
+   bool mFilterThreadLocal;
+
+   transition_record record_of(const instruction_t& instr) const
+   {
+      return make_record(instr, mOperands);
+   }
+
    /**
     @details Like std::vector[], this subscript operator does not throw
     if mHB.size() > i and yields undefined behaviour otherwise.
     */
-   const VectorClock& operator[](const index_t i) const;
+   clock_view operator[](const index_t i) const;
 
-   void update_frontier(const transition_t& t, const VectorClock& clock);
+   /// @brief Sets the frontier of mRecords[i].tid to clock, which is the clock of mE[i].
+
+   void update_frontier(const index_t i, const clock_view& clock);
 
    /**
     @brief Returns <code>{ 0 < j < index | E[j] <: E[i] }</code>,
@@ -172,16 +335,15 @@ protected:
     !exists k . hb(E[j],E[k]) && hb(E[k],E[i])</code>.
     @complexity O(n^2) with n = |clock|.
     */
-   VectorClock::indices_t covering(const index_t i, const instruction_t& instr,
+   VectorClock::indices_t covering(const index_t i, const transition_record& instr,
                                    VectorClock C) const;
 
-   /// @brief This HappensBefore is restored from a reset iff mIndex == mHB.size()-1.
-
-   bool restored() const;
+   bool frontier_valid_for(const index_t i) const;
 
-   bool not_restored() const;
+   /// @brief Returns true iff thread-local filtering is enabled and instr.operand is thread-local
+   /// to instr.tid.
 
-   bool frontier_valid_for(const index_t i) const;
+   bool thread_local_to(const transition_record& instr) const;
 
    /// @brief Returns true iff the happens-before relation is already defined on the prefix
    /// pre+(mE,i).
@@ -193,24 +355,25 @@ protected:
    static std::string outputname();
 
 private:
-   bool happens_before(const index_t i1, const VectorClock& clock2) const;
+   bool happens_before(const index_t i1, const clock_view& clock2) const;
 
    /// @brief Returns the VectorClock corresponding to the previous Transition by tid in
    /// pre(E,i).tid.
    /// @note The case where mE[mIndex].instr().tid == tid and where it is not yield different types
    /// of clocks, i.e. with different values set for tid.
 
-   const VectorClock& previous_by(const program_model::Thread::tid_t& tid) const;
+   clock_view previous_by(const program_model::Thread::tid_t& tid) const;
 
 }; // end class HappensBeforeBase
 
 
-template <typename Dependence>
+template <typename Dependence, typename clock_t = VectorClock>
 class HappensBefore : public HappensBeforeBase
 {
 public:
    explicit HappensBefore(const execution_t& E)
    : HappensBeforeBase(E)
+   , mThreadClocks(mFrontier)
    {
    }
 
@@ -219,6 +382,15 @@ public:
 
    void update(const index_t i);
 
+   /// @brief Wrapper of HappensBeforeBase::pop_back that also keeps mAccesses defined on the
+   /// prefix preceding the last Transition and rolls back mThreadClocks.
+
+   void pop_back();
+
+   /// @brief Wrapper of HappensBeforeBase::reset that also resizes mThreadClocks.
+
+   void reset();
+
    /// @brief Returns the index of the most recent Transition in pre(mE,index) that is dependent
    /// with the given instruction (and satisfies the given other conditions). Returns 0 iff there
    /// is no such Transition.
@@ -242,43 +414,103 @@ public:
    VectorClock::indices_t covering(const index_t i, const instruction_t& instr) const;
 
 private:
+   /// @brief Indexes the accesses of pre(mE, mHB.size()-1), i.e. of all Transitions but the last.
+   access_index<Dependence> mAccesses;
+
+   /// @brief The clocks of mFrontier as clock_t objects, into which new clocks are joined.
+   detail::thread_clocks<clock_t> mThreadClocks;
+
    /// @brief Returns the happens-before edges for instr in pre(mE,i).instr.
    /// @note Yields undefined behaviour if instr.tid == mE[i].instr.tid but !defined_on_prefix(i).
 
-   VectorClock clock(const index_t i, const instruction_t& instr) const;
+   VectorClock clock(const index_t i, const transition_record& instr) const;
+
+   /// @brief Returns the same VectorClock as detail::create_clock, i.e. the join of the clocks of
+   /// the Transitions in pre(mE,i) that are dependent with instr. If mAccesses is defined on
+   /// pre(mE,i), the clock is joined from the previous Transition by instr.tid and the dependent
+   /// accesses in mAccesses only. Otherwise, it falls back to scanning pre(mE,i).
+   /// @pre frontier_valid_for(i-1) or (frontier_valid_for(i) and instr.tid != mE[i].tid)
+
+   VectorClock dependent_clock(const index_t i, const transition_record& instr) const;
 
-}; // end class template HappensBefore<Dependence>
+}; // end class template HappensBefore<Dependence, clock_t>
 
 //--------------------------------------------------------------------------------------------------
 
-template <typename Dependence>
-void HappensBefore<Dependence>::update(const index_t i)
+template <typename Dependence, typename clock_t>
+void HappensBefore<Dependence, clock_t>::update(const index_t i)
 {
    /// @pre defined_on_prefix(i-1) && frontier_valid_for(i-1)
    assert(defined_on_prefix(i - 1) && frontier_valid_for(i - 1));
    DEBUGF(outputname(), "update", "[" << i << "]", "\n");
-   mHB.push_back(detail::create_clock<Dependence>(mE, mHB, i, mE[i].instr()));
-   update_frontier(mE[i], mHB.back());
+   while (mAccesses.size() + 1 < i)
+   {
+      mAccesses.push_back(mRecords[mAccesses.size() + 1]);
+   }
+   const transition_record record = record_of(mE[i].instr());
+   const auto tid = record.tid;
+   mOperands.record_access(record.operand, tid);
+   const auto previous = mFrontier[tid][tid];
+   auto& clock = mThreadClocks.advance(mFrontier, tid, i);
+   // The accesses to a thread-local operand are all by tid and hence already in clock
+   if (!thread_local_to(record))
+   {
+      mAccesses.for_each_dependent(record, [this, &record, &clock](const index_t j) {
+         if (mThreadClocks.join(clock, mFrontier, mHB, j, mRecords[j].tid))
+            mOperands.record_join(record.operand);
+      });
+   }
+   // The relation stores the irreflexive clock
+   mHB.push_back(clock, tid, previous);
+   mRecords.push_back(record);
+   update_frontier(i, mHB.back());
    /// @post defined_on_prefix(i) && frontier_valid_for(i)
    assert(defined_on_prefix(i) && frontier_valid_for(i));
 }
 
 //--------------------------------------------------------------------------------------------------
 
-template <typename Dependence>
-VectorClock::index_t HappensBefore<Dependence>::max_dependent(
+template <typename Dependence, typename clock_t>
+void HappensBefore<Dependence, clock_t>::pop_back()
+{
+   const auto tid = HappensBeforeBase::pop_back();
+   mThreadClocks.pop_back(mFrontier, tid);
+   while (mAccesses.size() + 1 > std::max<std::size_t>(mHB.size() - 1, 1))
+   {
+      mAccesses.pop_back();
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+template <typename Dependence, typename clock_t>
+void HappensBefore<Dependence, clock_t>::reset()
+{
+   HappensBeforeBase::reset();
+   mThreadClocks.reset(mFrontier);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+template <typename Dependence, typename clock_t>
+VectorClock::index_t HappensBefore<Dependence, clock_t>::max_dependent(
    const index_t index, const instruction_t& instruction,
    const bool apply_thread_transitive_reduction, const bool apply_coenabled) const
 {
    /// @pre frontier_valid_for(index)
    assert(frontier_valid_for(index));
 
-   VectorClock C = clock(index, instruction);
+   const transition_record record = record_of(instruction);
+   if ((apply_thread_transitive_reduction || apply_coenabled) && thread_local_to(record))
+   {
+      return 0;
+   }
+   VectorClock C = clock(index, record);
 
    DEBUGF(outputname(), "max_dependent",
           "[" << index << "], " << instruction << (apply_coenabled ? ", coenabled" : ""), "\n");
 
-   const auto tid = boost::apply_visitor(program_model::get_tid(), instruction);
+   const auto tid = record.tid;
 
    if (apply_thread_transitive_reduction)
    {
@@ -292,8 +524,8 @@ VectorClock::index_t HappensBefore<Dependence>::max_dependent(
    //
    if (apply_coenabled)
    {
-      while (*max_it > 0 && (!Dependence::dependent(mE[*max_it].instr(), instruction) ||
-                             !Dependence::coenabled(mE[*max_it].instr(), instruction)))
+      while (*max_it > 0 && (!Dependence::dependent(mRecords[*max_it], record) ||
+                             !Dependence::coenabled(mRecords[*max_it], record)))
       {
          program_model::Thread::tid_t max_tid = std::distance(C.cbegin(), max_it);
          C[max_tid] = mHB[*max_it][max_tid];
@@ -307,16 +539,21 @@ VectorClock::index_t HappensBefore<Dependence>::max_dependent(
 
 //--------------------------------------------------------------------------------------------------
 
-template <typename Dependence>
-VectorClock::indices_t HappensBefore<Dependence>::max_dependent_per_thread(
+template <typename Dependence, typename clock_t>
+VectorClock::indices_t HappensBefore<Dependence, clock_t>::max_dependent_per_thread(
    const index_t i, const instruction_t& instr, const bool use_thread_transitive_reduction) const
 {
    /// @pre frontier_valid_for(i)
    assert(frontier_valid_for(i));
    DEBUGF("\t" << outputname(), "max_dependent_per_thread", "[" << i << "], " << instr, "\n");
    VectorClock::indices_t MaxDep{};
-   VectorClock C = clock(i, instr);
-   const auto tid = boost::apply_visitor(program_model::get_tid(), instr);
+   const transition_record record = record_of(instr);
+   if (thread_local_to(record))
+   {
+      return MaxDep;
+   }
+   VectorClock C = clock(i, record);
+   const auto tid = record.tid;
    if (use_thread_transitive_reduction)
    {
       thread_transitive_reduction(i, tid, C);
@@ -325,9 +562,9 @@ VectorClock::indices_t HappensBefore<Dependence>::max_dependent_per_thread(
    VectorClock::index_t j;
    while (j = max_element(C), j > 0)
    {
-      const instruction_t& instr_j = mE[j].instr();
-      const auto tid_j = boost::apply_visitor(program_model::get_tid(), instr_j);
-      if (Dependence::dependent(instr_j, instr))
+      const transition_record& record_j = mRecords[j];
+      const auto tid_j = record_j.tid;
+      if (Dependence::dependent(record_j, record))
       {
          MaxDep.insert(j);
          C[tid_j] = 0;
@@ -345,21 +582,58 @@ VectorClock::indices_t HappensBefore<Dependence>::max_dependent_per_thread(
 
 //--------------------------------------------------------------------------------------------------
 
-template <typename Dependence>
-VectorClock::indices_t HappensBefore<Dependence>::covering(const index_t i,
+template <typename Dependence, typename clock_t>
+VectorClock::indices_t HappensBefore<Dependence, clock_t>::covering(const index_t i,
                                                            const instruction_t& instr) const
 {
-   return HappensBeforeBase::covering(i, instr, clock(i, instr));
+   const transition_record record = record_of(instr);
+   if (thread_local_to(record))
+   {
+      return {};
+   }
+   return HappensBeforeBase::covering(i, record, clock(i, record));
 }
 
 //--------------------------------------------------------------------------------------------------
 
-template <typename Dependence>
-VectorClock HappensBefore<Dependence>::clock(const index_t i, const instruction_t& instr) const
+template <typename Dependence, typename clock_t>
+VectorClock HappensBefore<Dependence, clock_t>::clock(const index_t i,
+                                                     const transition_record& instr) const
+{
+   if (instr.tid == mRecords[i].tid)
+   {
+      return VectorClock{(*this)[i], mHB.width()};
+   }
+   return dependent_clock(i, instr);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+template <typename Dependence, typename clock_t>
+VectorClock HappensBefore<Dependence, clock_t>::dependent_clock(const index_t i,
+                                                               const transition_record& instr) const
 {
-   const auto tid = boost::apply_visitor(program_model::get_tid(), instr);
-   const auto tid_i = boost::apply_visitor(program_model::get_tid(), mE[i].instr());
-   return tid == tid_i ? (*this)[i] : detail::create_clock<Dependence>(mE, mHB, i, instr);
+   if (mAccesses.size() + 1 != i)
+   {
+      return detail::create_clock<Dependence>(mRecords, mHB, i, instr, mOperands);
+   }
+   // The previous Transition by instr.tid knows every other Transition by instr.tid in pre(mE,i)
+   VectorClock clock = mFrontier[instr.tid];
+   if (!thread_local_to(instr))
+   {
+      mAccesses.for_each_dependent(instr, [this, &instr, &clock](const index_t j) {
+         const auto tid_j = mRecords[j].tid;
+         const auto value = static_cast<VectorClock::value_t>(j);
+         if (clock[tid_j] < value)
+         {
+            mOperands.record_join(instr.operand);
+            clock.max(mHB[j]);
+            clock[tid_j] = value;
+         }
+      });
+   }
+   DEBUGF(outputname(), "dependent_clock", "[" << i << "], " << instr, " = " << clock << "\n");
+   return clock;
 }
 
 //--------------------------------------------------------------------------------------------------
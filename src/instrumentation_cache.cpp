@@ -0,0 +1,151 @@
+
+#include "instrumentation_cache.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+#include <unistd.h>
+
+#define INSTRUMENTATION_CACHE_STRING(x) #x
+#define INSTRUMENTATION_CACHE_TO_STRING(x) INSTRUMENTATION_CACHE_STRING(x)
+
+
+namespace exploration {
+namespace {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief 64-bit FNV-1a, which is sufficient to tell apart the versions of a program that share
+/// a cache.
+
+class hash
+{
+public:
+   void add(const char* data, const std::size_t size)
+   {
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         mValue ^= static_cast<unsigned char>(data[i]);
+         mValue *= 1099511628211ull;
+      }
+   }
+
+   /// @brief Adds string followed by a separator, so that consecutive strings do not run into
+   /// each other.
+
+   void add(const std::string& string) { add(string.c_str(), string.size() + 1); }
+
+   void add_file(const boost::filesystem::path& file)
+   {
+      std::ifstream ifs(file.string(), std::ios::binary);
+      if (!ifs)
+         throw std::runtime_error("Could not read " + file.string());
+      char buffer[1 << 16];
+      while (ifs.read(buffer, sizeof(buffer)) || ifs.gcount() > 0)
+         add(buffer, static_cast<std::size_t>(ifs.gcount()));
+   }
+
+   /// @brief Adds the name, size and modification time of the regular files in directory.
+
+   void add_directory(const boost::filesystem::path& directory)
+   {
+      boost::system::error_code error;
+      for (boost::filesystem::directory_iterator it(directory, error), end; !error && it != end;
+           it.increment(error))
+      {
+         if (boost::filesystem::is_regular_file(it->status()))
+         {
+            add(it->path().filename().string());
+            add(std::to_string(boost::filesystem::file_size(it->path())));
+            add(std::to_string(boost::filesystem::last_write_time(it->path())));
+         }
+      }
+   }
+
+   std::string hex() const
+   {
+      std::ostringstream os;
+      os << std::hex << std::setw(16) << std::setfill('0') << mValue;
+      return os.str();
+   }
+
+private:
+   std::uint64_t mValue = 14695981039346656037ull;
+
+}; // end class hash
+
+} // end namespace
+
+//--------------------------------------------------------------------------------------------------
+
+instrumentation_cache::instrumentation_cache(const boost::filesystem::path& directory)
+: mDirectory(boost::filesystem::absolute(directory))
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+
+scheduler::program_t instrumentation_cache::instrument(const scheduler::program_t& program,
+                                                       const std::string& optimization_level,
+                                                       const std::string& compiler_options) const
+{
+   const auto entry = mDirectory / key(program, optimization_level, compiler_options);
+   const auto executable = entry / boost::filesystem::path(program).stem();
+   if (boost::filesystem::exists(executable))
+      return executable;
+
+   boost::filesystem::create_directories(mDirectory);
+   const auto staging = entry.string() + ".tmp." + std::to_string(getpid());
+   const auto instrumented =
+      scheduler::instrument(program, staging, optimization_level, compiler_options);
+   boost::system::error_code error;
+   boost::filesystem::rename(staging, entry, error);
+   if (error)
+   {
+      // Another exploration instrumented the same entry in the meantime
+      boost::filesystem::remove_all(staging);
+   }
+   return entry / boost::filesystem::path(instrumented).filename();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::string instrumentation_cache::key(const scheduler::program_t& program,
+                                       const std::string& optimization_level,
+                                       const std::string& compiler_options)
+{
+   hash key;
+   key.add(boost::filesystem::path(program).filename().string());
+   key.add_file(program);
+   key.add(optimization_level);
+   key.add(compiler_options);
+#ifdef LLVM_BIN
+   key.add(INSTRUMENTATION_CACHE_TO_STRING(LLVM_BIN));
+#endif
+#ifdef RECORD_REPLAY_BUILD_DIR
+   const boost::filesystem::path record_replay_build =
+      INSTRUMENTATION_CACHE_TO_STRING(RECORD_REPLAY_BUILD_DIR);
+   key.add(record_replay_build.string());
+   key.add_directory(record_replay_build / "llvm-pass");
+   key.add_directory(record_replay_build / "scheduler");
+#endif
+   return key.hex();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+boost::filesystem::path instrumentation_cache::default_directory()
+{
+   if (const char* xdg_cache_home = std::getenv("XDG_CACHE_HOME"))
+      return boost::filesystem::path(xdg_cache_home) / "state-space-explorer";
+   const char* home = std::getenv("HOME");
+   return boost::filesystem::path(home ? home : ".") / ".cache" / "state-space-explorer";
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
@@ -0,0 +1,61 @@
+#pragma once
+
+// SCHEDULER
+#include "replay.hpp"
+#include "schedule.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <string>
+
+//--------------------------------------------------------------------------------------------------
+/// @file instrumentation_cache.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief A content-addressed store of instrumented executables, shared by all explorations that
+/// use the same directory.
+/// @details An entry is keyed by the contents of the input program, the optimization level, the
+/// compiler options and the version of the instrumentation tool chain, i.e. the LLVM binaries and
+/// the size and modification time of the files of the Record-Replay instrumentation pass and
+/// scheduler library. Files included by the input program are not part of the key.
+/// A missing entry is instrumented into a private directory that is then renamed to the entry,
+/// so that concurrent explorations never see a partially instrumented entry.
+
+class instrumentation_cache
+{
+public:
+   explicit instrumentation_cache(const boost::filesystem::path& directory);
+
+   /// @brief Returns the instrumented executable of program from the entry of its key,
+   /// instrumenting program with scheduler::instrument if there is no such entry.
+
+   scheduler::program_t instrument(const scheduler::program_t& program,
+                                   const std::string& optimization_level,
+                                   const std::string& compiler_options) const;
+
+   /// @brief Returns the hexadecimal key of the entry of program.
+
+   static std::string key(const scheduler::program_t& program,
+                          const std::string& optimization_level,
+                          const std::string& compiler_options);
+
+   /// @brief Returns $XDG_CACHE_HOME/state-space-explorer, or ~/.cache/state-space-explorer if
+   /// XDG_CACHE_HOME is not set.
+
+   static boost::filesystem::path default_directory();
+
+private:
+   boost::filesystem::path mDirectory;
+
+}; // end class instrumentation_cache
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
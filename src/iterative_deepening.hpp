@@ -0,0 +1,97 @@
+#pragma once
+
+#include "bound.hpp"
+#include "depth_first_search.hpp"
+#include "exploration.hpp"
+
+#include <boost/filesystem.hpp>
+
+//--------------------------------------------------------------------------------------------------
+/// @file iterative_deepening.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Explores the state-space of program with bounds 0, 1, ..., max_bound of
+/// bound_function_t, where every bound only explores the executions that the previous bound did
+/// not. Level 0 is a bounded search with bound 0. Level k+1 explores, with bound k+1, the subtrees
+/// rooted at the branches that level k pruned (see bound::record_pruned), each in an
+/// Exploration whose floor is the length of the branch.
+/// @details The explorations of level k run in output_dir/bound-k, whose statistics.txt holds
+/// one entry per subtree. The statistics per level are appended to output_dir/statistics.txt.
+/// Exploring stops when max_nr_explorations explorations were made in total, when a level
+/// pruned nothing or when a budget of settings ran out. In the latter case, the subtrees of the
+/// level left unexplored are listed in its frontier.txt.
+/// @returns The statistics per level, of which the first k+1 together cover the executions of a
+/// bounded search with bound k.
+
+template <typename bound_function_t>
+std::vector<ExplorationStatistics> iterative_deepening(
+   const scheduler::program_t& program, const unsigned int max_nr_explorations,
+   const typename bound_function_t::value_t max_bound, const Settings& settings,
+   const std::string& optimization_level, const std::string& compiler_options,
+   const boost::filesystem::path& output_dir)
+{
+   using mode_t = depth_first_search<bound<bound_function_t>>;
+
+   if (boost::filesystem::exists(output_dir))
+      boost::filesystem::remove_all(output_dir);
+   boost::filesystem::create_directories(output_dir);
+
+   const auto instrumented_executable = detail::instrument(
+      program, output_dir, optimization_level, compiler_options, settings.instrumentation_cache);
+
+   std::vector<ExplorationStatistics> levels{};
+   std::vector<scheduler::schedule_t> frontier{{}};
+   unsigned int nr_explorations = 0;
+   bool exhausted_budget = false;
+   for (typename bound_function_t::value_t bound_value = 0;
+        bound_value <= max_bound && !frontier.empty() && nr_explorations < max_nr_explorations &&
+        !exhausted_budget;
+        ++bound_value)
+   {
+      const auto level_dir = output_dir / ("bound-" + std::to_string(bound_value));
+      boost::filesystem::create_directories(level_dir);
+      levels.emplace_back();
+      levels.back().start_clock();
+      std::vector<scheduler::schedule_t> pruned{};
+      for (const auto& root : frontier)
+      {
+         if (nr_explorations >= max_nr_explorations)
+            break;
+         Exploration<mode_t> exploration(program, max_nr_explorations - nr_explorations,
+                                         bound_value);
+         exploration.set_settings(settings);
+         exploration.mode().reduction().record_pruned(root.size());
+         exploration.explore(instrumented_executable, root, level_dir, root.size());
+         exploration.close(level_dir);
+         // The remaining subtrees of the level are explored up to the budget check and thus
+         // end up in its frontier.txt
+         exhausted_budget = exhausted_budget || bool(exploration.exhausted_budget());
+         const auto nr = exploration.statistics().nr_explorations();
+         levels.back().increase_nr_explorations(nr);
+         nr_explorations += nr;
+         auto subtree_pruned = exploration.mode().reduction().take_pruned();
+         pruned.insert(pruned.end(), std::make_move_iterator(subtree_pruned.begin()),
+                       std::make_move_iterator(subtree_pruned.end()));
+      }
+      levels.back().stop_clock();
+      {
+         std::ofstream ofs((output_dir / "statistics.txt").string(), std::ofstream::app);
+         ofs << "bound\t" << bound_value << std::endl
+             << "nr_pruned\t" << pruned.size() << std::endl;
+      }
+      levels.back().dump(output_dir / "statistics.txt");
+      frontier = std::move(pruned);
+   }
+   return levels;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
@@ -0,0 +1,25 @@
+
+#include "operand_interner.hpp"
+
+#include "visible_instruction_io.hpp"
+
+#include <ostream>
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+void operand_interner::dump(std::ostream& os) const
+{
+   for (id_t id = 0; id < size(); ++id)
+   {
+      const statistics_t& statistics = mStatistics[id];
+      os << operand(id) << "\t" << statistics.nr_accesses << "\t" << statistics.threads << "\t"
+         << statistics.nr_joins << std::endl;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
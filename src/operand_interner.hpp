@@ -0,0 +1,95 @@
+#pragma once
+
+#include "tid_set.hpp"
+
+#include "visible_instruction.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file operand_interner.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Maps every distinct operand of a visible instruction to a dense id, in the order in
+/// which the operands are first seen, and keeps statistics per operand.
+/// @details Ids are never reassigned, so they are stable across the explorations that share an
+/// operand_interner. Data structures per operand can therefore be indexed by id.
+
+class operand_interner
+{
+public:
+   using operand_t = program_model::get_operand::result_type;
+   using id_t = std::uint32_t;
+
+   struct statistics_t
+   {
+      /// @brief The number of explored Transitions that accessed the operand.
+      unsigned int nr_accesses = 0;
+
+      /// @brief The threads that accessed the operand.
+      tid_set threads;
+
+      /// @brief The number of times a happens-before clock joined the clock of a Transition of
+      /// another thread because of a dependence through the operand.
+      /// @note This counts joins, not the pairs for which Dependence::dependent holds: an access
+      /// that already happens before the clock is not joined again, and the access index only
+      /// visits the last exclusive access and the non-exclusive accesses after it.
+      unsigned int nr_joins = 0;
+   };
+
+   /// @brief Returns the id of operand, assigning it the next id if it is new.
+
+   id_t intern(const operand_t& operand)
+   {
+      const auto inserted = mIds.emplace(operand, static_cast<id_t>(mIds.size()));
+      if (inserted.second)
+      {
+         mOperands.push_back(inserted.first);
+         mStatistics.emplace_back();
+      }
+      return inserted.first->second;
+   }
+
+   /// @brief Returns the number of interned operands, i.e. the ids are [0, size()).
+
+   std::size_t size() const { return mIds.size(); }
+
+   const operand_t& operand(const id_t id) const { return mOperands[id]->first; }
+
+   const statistics_t& statistics(const id_t id) const { return mStatistics[id]; }
+
+   void record_access(const id_t id, const program_model::Thread::tid_t tid)
+   {
+      ++mStatistics[id].nr_accesses;
+      mStatistics[id].threads.insert(tid);
+   }
+
+   void record_join(const id_t id) { ++mStatistics[id].nr_joins; }
+
+   /// @brief Writes a line "operand nr_accesses threads nr_joins" for every operand.
+
+   void dump(std::ostream& os) const;
+
+private:
+   std::map<operand_t, id_t> mIds;
+
+   /// @brief mOperands[id] points to the entry of id in mIds.
+   std::vector<std::map<operand_t, id_t>::const_iterator> mOperands;
+
+   std::vector<statistics_t> mStatistics;
+
+}; // end class operand_interner
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
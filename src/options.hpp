@@ -1,4 +1,6 @@
 
+#include <exploration.hpp>
+#include <instrumentation_cache.hpp>
 #include <replay.hpp>
 
 #include <boost/program_options.hpp>
@@ -14,25 +16,69 @@ public:
    {
       m_options_desc.add_options()("h", "help")(
          "bound", boost::program_options::value<unsigned int>()->default_value(0),
-         "the bound to be used with a Bounded Search based exploration")(
+         "the bound to be used with a Bounded Search or bound-persistent DPOR based exploration")(
          "bound-function",
          boost::program_options::value<std::string>()->default_value("preemptions"),
-         "the bound function to be used with a Bounded Search based exploration "
-         "(values:preemptions)")("c",
+         "the bound function to be used with a Bounded Search or bound-persistent DPOR based "
+         "exploration (values:preemptions)")(
+         "bound-alternative-thread", boost::program_options::value<bool>()->default_value(true),
+         "with bound-persistent, add a single alternative thread instead of all enabled threads "
+         "at a backtrack point where the racing thread is disabled")(
+         "bound-opt", boost::program_options::value<bool>()->default_value(true),
+         "with bound-persistent, defer the conservative backtrack points to states where the "
+         "bound was exceeded (implied by bound-sleepsets conservative)")(
+         "bound-sleepsets",
+         boost::program_options::value<std::string>()->default_value("conservative"),
+         "with bound-persistent, the use of sleepsets (values: never, conservative)")(
+         "bound-transitive-reduction",
+         boost::program_options::value<bool>()->default_value(true),
+         "with bound-persistent, only add backtrack points for races in the thread transitive "
+         "reduction of the happens-before relation")("c",
                                  boost::program_options::value<std::string>()->default_value(""),
                                  "compiler options for compiling the system under test")(
+         "checkpoint-interval", boost::program_options::value<unsigned int>(),
+         "the minimum time in seconds between two checkpoints of the exploration state, written "
+         "to checkpoint.bin in the output directory (not with workers or iterative)")(
+         "depth", boost::program_options::value<unsigned int>()->default_value(3),
+         "the depth (number of priority change points + 1) of a PCT based random search")(
          "i", boost::program_options::value<std::string>(),
          "the system under test, instrumented with the Record-Replay compiler pass")(
+         "instrumentation-cache",
+         boost::program_options::value<std::string>()->default_value(
+            exploration::instrumentation_cache::default_directory().string()),
+         "the directory of the cache of instrumented executables that is shared between runs "
+         "(empty: instrument into the output directory)")(
+         "iterative", boost::program_options::value<bool>()->default_value(false),
+         "with a Bounded Search, explore the bounds 0 up to bound in turn, where every bound only "
+         "explores the branches pruned by the previous one")(
          "max", boost::program_options::value<unsigned int>(),
          "the maximum number of executions explored")(
+         "memory-budget", boost::program_options::value<unsigned int>(),
+         "the peak resident set size in MiB of the explorer plus its largest execution, after "
+         "which no new execution is explored")(
          "o", boost::program_options::value<std::string>(),
          "the directory where output files are dumped")(
          "opt", boost::program_options::value<std::string>()->default_value("0"),
          "the optimization level for compiling the system under test")(
+         "resume", boost::program_options::value<std::string>(),
+         "a checkpoint to resume the exploration from, in the output directory of the "
+         "checkpointed exploration (not with workers or iterative)")(
+         "seed", boost::program_options::value<unsigned int>()->default_value(0),
+         "the seed of a random search, worker i of a parallel random search uses seed + i")(
+         "strategy", boost::program_options::value<std::string>()->default_value("uniform"),
+         "the strategy of a random search (values: uniform, pct)")(
+         "time-budget", boost::program_options::value<unsigned int>(),
+         "the wall-clock time in seconds, counted from the start of the run, after which no new "
+         "execution is explored")(
          "sufficient-set",
          boost::program_options::value<std::string>()->default_value("persistent"),
          "the sufficient set implementation to be used with DPOR based exploration (values: "
-         "persistent)");
+         "persistent, source, optimal, bound-persistent)")(
+         "thread-local-objects", boost::program_options::value<bool>()->default_value(false),
+         "with DPOR, collapse the transitions on objects that only one thread accesses out of "
+         "the backtrack analysis")(
+         "workers", boost::program_options::value<unsigned int>()->default_value(1),
+         "the number of worker processes exploring the state-space in parallel");
    }
 
    void parse(int argc, char* argv[])
@@ -81,4 +127,79 @@ std::pair<scheduler::program_t, unsigned int> get_required_options(const options
 
 //----------------------------------------------------------------------------------------------------------------------
 
+
+/// @brief Returns Settings with the deadline, memory budget, checkpoint interval,
+/// instrumentation cache and thread-local objects given by the corresponding options.
+/// @param resumable Whether the run is a single Exploration whose Mode supports checkpoints, in
+/// which case a budget that stops it leaves a checkpoint to resume it from.
+
+exploration::Settings get_settings(const options& opt, const bool resumable)
+{
+   exploration::Settings settings;
+   settings.checkpoint_on_budget = resumable;
+   if (opt.map().count("time-budget"))
+   {
+      settings.deadline = std::chrono::steady_clock::now() +
+                          std::chrono::seconds(opt.map()["time-budget"].as<unsigned int>());
+   }
+   if (opt.map().count("memory-budget"))
+   {
+      settings.memory_budget = opt.map()["memory-budget"].as<unsigned int>();
+   }
+   if (opt.map().count("checkpoint-interval"))
+   {
+      settings.checkpoint_interval =
+         std::chrono::seconds(opt.map()["checkpoint-interval"].as<unsigned int>());
+   }
+   if (opt.map().count("instrumentation-cache") &&
+       !opt.map()["instrumentation-cache"].as<std::string>().empty())
+   {
+      settings.instrumentation_cache = opt.map()["instrumentation-cache"].as<std::string>();
+   }
+   if (opt.map().count("thread-local-objects"))
+   {
+      settings.thread_local_objects = opt.map()["thread-local-objects"].as<bool>();
+   }
+   return settings;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+
+/// @brief Runs exploration, or resumes it from the checkpoint given by the --resume option.
+
+template <typename exploration_t>
+void run_or_resume(exploration_t& exploration, const options& opt,
+                   const boost::filesystem::path& output_dir)
+{
+   const std::string optimization_level = opt.map()["opt"].as<std::string>();
+   const std::string compiler_options = opt.map()["c"].as<std::string>();
+   if (opt.map().count("resume"))
+   {
+      exploration.resume(opt.map()["resume"].as<std::string>(), optimization_level,
+                         compiler_options, output_dir);
+   }
+   else
+   {
+      exploration.run({}, optimization_level, compiler_options, output_dir);
+   }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+
+/// @throws std::invalid_argument if --checkpoint-interval or --resume is given for a parallel or
+/// iterative exploration, which consists of more than a single Exploration.
+
+void check_checkpoint_options(const options& opt, const bool single_exploration)
+{
+   if (!single_exploration && (opt.map().count("checkpoint-interval") || opt.map().count("resume")))
+   {
+      throw std::invalid_argument(
+         "checkpoint-interval and resume require workers 1 (and iterative false)");
+   }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
 } // end namespace state_space_explorer
@@ -0,0 +1,373 @@
+
+#include "parallel_exploration.hpp"
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+
+namespace exploration {
+namespace parallel {
+namespace detail {
+
+//--------------------------------------------------------------------------------------------------
+
+namespace {
+
+void write_all(const int fd, const void* data, const std::size_t size)
+{
+   const char* bytes = static_cast<const char*>(data);
+   std::size_t written = 0;
+   while (written < size)
+   {
+      const ssize_t nr = ::write(fd, bytes + written, size - written);
+      if (nr < 0)
+         throw std::runtime_error("parallel::send: write failed");
+      written += nr;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void read_all(const int fd, void* data, const std::size_t size)
+{
+   char* bytes = static_cast<char*>(data);
+   std::size_t read = 0;
+   while (read < size)
+   {
+      const ssize_t nr = ::read(fd, bytes + read, size - read);
+      if (nr <= 0)
+         throw std::runtime_error("parallel::receive: read failed");
+      read += nr;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+struct worker
+{
+   pid_t pid;
+   int in;  // coordinator reads from
+   int out; // coordinator writes to
+   bool busy;
+   bool steal_pending;
+   unsigned int budget; // of the running job
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief The table of shared_state, mapping the prefix of a given up state to its sleepset and
+/// the order in which its tids were handed out.
+
+class table
+{
+public:
+   void add(const scheduler::schedule_t& prefix, const scheduler::schedule_t& sleepset,
+            const scheduler::schedule_t& order)
+   {
+      mEntries.emplace(prefix, entry{sleepset, order});
+   }
+
+   /// @brief Returns false iff schedule.back() was already handed out at, or is asleep in, the
+   /// state reached by the rest of schedule. Otherwise, it records that it is handed out now.
+
+   bool hand_out(const scheduler::schedule_t& schedule)
+   {
+      if (schedule.empty())
+         return true;
+      const auto it = mEntries.find({schedule.begin(), schedule.end() - 1});
+      if (it == mEntries.end())
+         return true;
+      const auto& sleepset = it->second.sleepset;
+      if (std::find(sleepset.begin(), sleepset.end(), schedule.back()) != sleepset.end())
+         return false;
+      auto& order = it->second.order;
+      if (std::find(order.begin(), order.end(), schedule.back()) != order.end())
+         return false;
+      order.push_back(schedule.back());
+      return true;
+   }
+
+   /// @brief Returns the seeds [index, tids...] for a job exploring the given schedule.
+
+   std::vector<scheduler::schedule_t> seeds(const scheduler::schedule_t& schedule) const
+   {
+      std::vector<scheduler::schedule_t> seeds;
+      for (std::size_t index = 0; index < schedule.size(); ++index)
+      {
+         const auto it = mEntries.find({schedule.begin(), schedule.begin() + index});
+         if (it == mEntries.end())
+            continue;
+         seeds.push_back({static_cast<int>(index)});
+         seeds.back().insert(seeds.back().end(), it->second.sleepset.begin(),
+                             it->second.sleepset.end());
+         for (const auto& tid : it->second.order)
+         {
+            if (tid == schedule[index])
+               break;
+            seeds.back().push_back(tid);
+         }
+      }
+      return seeds;
+   }
+
+private:
+   struct entry
+   {
+      scheduler::schedule_t sleepset;
+      scheduler::schedule_t order;
+   };
+
+   std::map<scheduler::schedule_t, entry> mEntries;
+
+}; // end class table
+
+} // end namespace
+
+//--------------------------------------------------------------------------------------------------
+
+void send(const int fd, const message_t type, const std::vector<int>& payload)
+{
+   const int header[2] = {static_cast<int>(type), static_cast<int>(payload.size())};
+   write_all(fd, header, sizeof(header));
+   write_all(fd, payload.data(), payload.size() * sizeof(int));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+message receive(const int fd)
+{
+   int header[2];
+   read_all(fd, header, sizeof(header));
+   message msg{static_cast<message_t>(header[0]), std::vector<int>(header[1])};
+   read_all(fd, msg.payload.data(), msg.payload.size() * sizeof(int));
+   return msg;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool pending(const int fd)
+{
+   pollfd pfd{fd, POLLIN, 0};
+   return ::poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::vector<int> encode(const std::vector<scheduler::schedule_t>& schedules)
+{
+   std::vector<int> payload;
+   for (const auto& schedule : schedules)
+   {
+      payload.push_back(schedule.size());
+      payload.insert(payload.end(), schedule.begin(), schedule.end());
+   }
+   return payload;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::vector<scheduler::schedule_t> decode(const std::vector<int>& payload)
+{
+   std::vector<scheduler::schedule_t> schedules;
+   for (auto it = payload.begin(); it != payload.end(); it += schedules.back().size())
+   {
+      const auto size = *it++;
+      schedules.emplace_back(it, it + size);
+   }
+   return schedules;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+unsigned int coordinate(const unsigned int nr_workers, std::deque<scheduler::schedule_t> jobs,
+                        const unsigned int max_nr_explorations, const worker_main_t& worker_main)
+{
+   std::vector<worker> workers;
+   for (unsigned int id = 0; id < nr_workers; ++id)
+   {
+      int to_worker[2], from_worker[2];
+      if (::pipe(to_worker) != 0 || ::pipe(from_worker) != 0)
+         throw std::runtime_error("parallel::coordinate: pipe failed");
+      const pid_t pid = ::fork();
+      if (pid < 0)
+         throw std::runtime_error("parallel::coordinate: fork failed");
+      if (pid == 0)
+      {
+         ::close(to_worker[1]);
+         ::close(from_worker[0]);
+         for (const auto& other : workers)
+         {
+            ::close(other.in);
+            ::close(other.out);
+         }
+         int status = 0;
+         try
+         {
+            worker_main(id, to_worker[0], from_worker[1]);
+         }
+         catch (const std::exception& e)
+         {
+            ERROR("parallel::worker_" + std::to_string(id), e.what());
+            status = 1;
+         }
+         // Do not run the coordinator's atexit handlers and destructors
+         ::_exit(status);
+      }
+      ::close(to_worker[0]);
+      ::close(from_worker[1]);
+      workers.push_back({pid, from_worker[0], to_worker[1], false, false, 0});
+   }
+
+   table handed_out;
+   const auto add_job = [&jobs, &handed_out](scheduler::schedule_t& job) {
+      if (handed_out.hand_out(job))
+         jobs.push_back(std::move(job));
+   };
+
+   unsigned int nr_explorations = 0;
+   // The part of max_nr_explorations that is neither explored nor held by a running job
+   unsigned int unassigned = max_nr_explorations;
+   std::size_t victim = 0;
+   try
+   {
+      while (true)
+      {
+         // Hand out queued jobs to idle workers, sharing the unassigned budget among them
+         auto nr_idle = std::count_if(workers.begin(), workers.end(),
+                                      [](const auto& w) { return !w.busy; });
+         for (auto& w : workers)
+         {
+            if (!w.busy && !jobs.empty() && unassigned > 0)
+            {
+               const auto nr_shares = std::min<std::size_t>(jobs.size(), nr_idle--);
+               w.budget = std::max<unsigned int>(1, unassigned / nr_shares);
+               unassigned -= w.budget;
+               std::vector<scheduler::schedule_t> parts{{static_cast<int>(w.budget)},
+                                                        jobs.front()};
+               for (auto& seed : handed_out.seeds(jobs.front()))
+                  parts.push_back(std::move(seed));
+               jobs.pop_front();
+               send(w.out, message_t::job, encode(parts));
+               w.busy = true;
+            }
+         }
+         nr_idle = std::count_if(workers.begin(), workers.end(),
+                                 [](const auto& w) { return !w.busy; });
+         // Jobs that are left at this point are dropped, as the budget is spent
+         if (nr_idle == static_cast<long>(workers.size()))
+            break;
+         // Ask one busy worker at a time to give up part of its subtree and its budget
+         if (nr_idle > 0 && jobs.empty() &&
+             std::none_of(workers.begin(), workers.end(),
+                          [](const auto& w) { return w.steal_pending; }))
+         {
+            for (std::size_t i = 0; i < workers.size(); ++i)
+            {
+               auto& w = workers[(victim + i) % workers.size()];
+               if (w.busy)
+               {
+                  send(w.out, message_t::steal);
+                  w.steal_pending = true;
+                  victim = (victim + i + 1) % workers.size();
+                  break;
+               }
+            }
+         }
+
+         std::vector<pollfd> fds;
+         for (const auto& w : workers)
+            fds.push_back({w.in, POLLIN, 0});
+         if (::poll(fds.data(), fds.size(), -1) < 0)
+            throw std::runtime_error("parallel::coordinate: poll failed");
+         for (std::size_t i = 0; i < workers.size(); ++i)
+         {
+            if (fds[i].revents == 0)
+               continue;
+            auto& w = workers[i];
+            const message msg = receive(w.in);
+            if (msg.type == message_t::done)
+            {
+               const auto nr = static_cast<unsigned int>(msg.payload.front());
+               nr_explorations += nr;
+               unassigned += w.budget - std::min(nr, w.budget);
+               w.budget = 0;
+               w.busy = false;
+            }
+            else if (msg.type == message_t::levels)
+            {
+               const auto entries = decode(msg.payload);
+               for (std::size_t e = 0; e + 2 < entries.size(); e += 3)
+                  handed_out.add(entries[e], entries[e + 1], entries[e + 2]);
+            }
+            else if (msg.type == message_t::jobs)
+            {
+               auto parts = decode(msg.payload);
+               const auto donated = std::min<unsigned int>(parts.front().front(), w.budget);
+               w.budget -= donated;
+               unassigned += donated;
+               std::for_each(parts.begin() + 1, parts.end(), add_job);
+               w.steal_pending = false;
+            }
+            else if (msg.type == message_t::backtrack)
+            {
+               for (auto& job : decode(msg.payload))
+                  add_job(job);
+            }
+         }
+      }
+      // A worker that finished before reading a steal request still answers it
+      for (auto& w : workers)
+      {
+         while (w.steal_pending)
+         {
+            if (receive(w.in).type == message_t::jobs)
+               w.steal_pending = false;
+         }
+      }
+   }
+   catch (const std::exception&)
+   {
+      // Busy workers only read a request after their job, so they are killed instead
+      for (auto& w : workers)
+      {
+         if (!w.busy)
+         {
+            try
+            {
+               send(w.out, message_t::terminate);
+            }
+            catch (const std::exception&)
+            {
+               w.busy = true;
+            }
+         }
+         if (w.busy)
+            ::kill(w.pid, SIGKILL);
+         ::waitpid(w.pid, nullptr, 0);
+         ::close(w.in);
+         ::close(w.out);
+      }
+      throw;
+   }
+
+   for (auto& w : workers)
+   {
+      send(w.out, message_t::terminate);
+      ::waitpid(w.pid, nullptr, 0);
+      ::close(w.in);
+      ::close(w.out);
+   }
+   return nr_explorations;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace detail
+} // end namespace parallel
+} // end namespace exploration
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "exploration.hpp"
+#include "sufficient_sets/sleep_set.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file parallel_exploration.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+template <typename reduction_t>
+class depth_first_search;
+template <typename sufficient_set_t>
+class dpor;
+
+namespace parallel {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief The state of a Mode, beyond the schedules themselves, that workers share through the
+/// coordinator. The coordinator keeps a table entry for every state that a worker gave up (i.e.
+/// that lies below its floor), consisting of the state's prefix, a sleepset and the order in
+/// which its tids were handed out. A job for schedule s is seeded, for every prefix s[0..l) in
+/// the table, with the sleepset of that entry extended with the tids handed out before s[l].
+/// As every tid then only sleeps in the subtrees of the tids handed out after it, the seeded
+/// sleepsets are those of a serial exploration that explores the tids in the order handed out.
+/// @details The default shares nothing, i.e. jobs are not seeded and no table entries are kept.
+
+template <typename Mode>
+struct shared_state
+{
+   /// @brief Applies the seeds, given as [index, tids...], of a job of length floor.
+   static void seed(Mode&, const std::vector<scheduler::schedule_t>&, const std::size_t) {}
+
+   /// @brief Returns the table entries, as triples [prefix], [sleepset], [order], for the states
+   /// with index in [from, to) that Mode gave up in a split.
+   static std::vector<scheduler::schedule_t> donate(Mode&, const scheduler::schedule_t&,
+                                                    const std::size_t, const std::size_t)
+   {
+      return {};
+   }
+
+   /// @brief Returns the schedules prefix.tid for tids that Mode added to the backtrack sets of
+   /// states below its floor, which are explored by the coordinator's other jobs.
+   static std::vector<scheduler::schedule_t> forwarded(Mode&) { return {}; }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+template <typename sufficient_set_t>
+struct shared_state<depth_first_search<dpor<sufficient_set_t>>>
+{
+   using mode_t = depth_first_search<dpor<sufficient_set_t>>;
+
+   static void seed(mode_t& mode, const std::vector<scheduler::schedule_t>& seeds,
+                    const std::size_t floor)
+   {
+      for (const auto& seed : seeds)
+      {
+         SleepSet sleepset;
+         std::for_each(seed.begin() + 1, seed.end(), [&sleepset](const auto& tid) {
+            sleepset.add(tid);
+         });
+         mode.reduction().seed(seed.front(), sleepset);
+      }
+      mode.reduction().set_floor(floor);
+   }
+
+   static std::vector<scheduler::schedule_t> donate(mode_t& mode,
+                                                    const scheduler::schedule_t& schedule,
+                                                    const std::size_t from, const std::size_t to)
+   {
+      std::vector<scheduler::schedule_t> entries;
+      for (auto index = from; index < to; ++index)
+      {
+         const auto& sleepset = mode.reduction().sufficient_set(index).sleepset().asleep();
+         const auto& done = mode.state(index).done();
+         entries.emplace_back(schedule.begin(), schedule.begin() + index);
+         entries.emplace_back(sleepset.begin(), sleepset.end());
+         entries.emplace_back(done.begin(), done.end());
+         entries.back().push_back(schedule[index]);
+      }
+      mode.reduction().set_floor(to);
+      return entries;
+   }
+
+   static std::vector<scheduler::schedule_t> forwarded(mode_t& mode)
+   {
+      return mode.reduction().take_forwarded();
+   }
+};
+
+//--------------------------------------------------------------------------------------------------
+
+namespace detail {
+
+//--------------------------------------------------------------------------------------------------
+
+enum class message_t : int
+{
+   job,       // coordinator -> worker: encoded [budget], schedule, seeds...
+   done,      // worker -> coordinator: [nr_explorations]
+   steal,     // coordinator -> worker: []
+   levels,    // worker -> coordinator: encoded table entries (see shared_state::donate)
+   jobs,      // worker -> coordinator: encoded [donated budget], schedules
+   backtrack, // worker -> coordinator: encoded schedules (see shared_state::forwarded)
+   terminate  // coordinator -> worker: []
+};
+
+struct message
+{
+   message_t type;
+   std::vector<int> payload;
+};
+
+/// @brief Writes a message of the given type and payload to file descriptor fd.
+
+void send(const int fd, const message_t type, const std::vector<int>& payload = {});
+
+/// @brief Blocks until a complete message can be read from file descriptor fd.
+/// @throws std::runtime_error if fd is closed or the read fails.
+
+message receive(const int fd);
+
+/// @brief Returns true iff a message can be read from file descriptor fd without blocking.
+
+bool pending(const int fd);
+
+std::vector<int> encode(const std::vector<scheduler::schedule_t>& schedules);
+
+std::vector<scheduler::schedule_t> decode(const std::vector<int>& payload);
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Function run by a worker process, with the file descriptors to read messages from and
+/// write messages to.
+
+using worker_main_t = std::function<void(unsigned int id, int in, int out)>;
+
+/// @brief Forks nr_workers worker processes running worker_main and hands out the given jobs,
+/// the jobs split off from busy workers and the backtrack points forwarded by them, to idle
+/// workers until all workers are idle and no job is left, or until max_nr_explorations
+/// explorations have been reported. Every job is handed out with a budget, such that the budgets
+/// of the running jobs and the reported explorations never exceed max_nr_explorations.
+/// Schedules prefix.tid for which the table of shared_state shows that tid was already handed
+/// out at, or is asleep in, prefix are dropped.
+/// @returns The total number of explorations reported by the workers.
+/// @throws std::runtime_error if a message cannot be received, after terminating the workers.
+
+unsigned int coordinate(const unsigned int nr_workers, std::deque<scheduler::schedule_t> jobs,
+                        const unsigned int max_nr_explorations,
+                        const worker_main_t& worker_main);
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Runs jobs sent by the coordinator, each in a fresh Exploration<Mode> restricted to the
+/// subtree rooted at the job's schedule, and answers steal requests by splitting the running
+/// exploration.
+
+template <typename Mode, typename... Args>
+void work(const int in, const int out, const scheduler::program_t& program,
+          const scheduler::program_t& instrumented_executable, const Settings& settings,
+          const boost::filesystem::path& worker_dir, Args... args)
+{
+   boost::filesystem::create_directories(worker_dir);
+   // The scheduler reads and writes its files relative to the current working directory
+   boost::filesystem::current_path(worker_dir);
+   using state_t = shared_state<Mode>;
+   while (true)
+   {
+      const message msg = receive(in);
+      if (msg.type == message_t::terminate)
+      {
+         return;
+      }
+      else if (msg.type == message_t::steal)
+      {
+         // The job finished before the steal request was read
+         send(out, message_t::jobs, encode({scheduler::schedule_t{0}}));
+      }
+      else if (msg.type == message_t::job)
+      {
+         const auto parts = decode(msg.payload);
+         const scheduler::schedule_t& job = parts[1];
+         Exploration<Mode> exploration(program, parts[0].front(), args...);
+         exploration.set_settings(settings);
+         state_t::seed(exploration.mode(), {parts.begin() + 2, parts.end()}, job.size());
+         const auto send_forwarded = [&exploration, out]() {
+            const auto forwarded = state_t::forwarded(exploration.mode());
+            if (!forwarded.empty())
+               send(out, message_t::backtrack, encode(forwarded));
+         };
+         exploration.set_iteration_hook([&exploration, &send_forwarded, in, out]() {
+            send_forwarded();
+            if (pending(in))
+            {
+               // Only steal requests are sent to busy workers
+               receive(in);
+               const auto floor = exploration.mode().floor();
+               auto jobs = exploration.split();
+               const auto levels = state_t::donate(exploration.mode(), exploration.schedule(),
+                                                   floor, exploration.mode().floor());
+               if (!levels.empty())
+                  send(out, message_t::levels, encode(levels));
+               // Half of the budget that is left goes with the given up subtrees
+               unsigned int donated = 0;
+               if (!jobs.empty())
+               {
+                  const auto max = exploration.max_nr_explorations();
+                  donated = (max - exploration.statistics().nr_explorations()) / 2;
+                  exploration.set_max_nr_explorations(max - donated);
+               }
+               jobs.insert(jobs.begin(), scheduler::schedule_t{static_cast<int>(donated)});
+               send(out, message_t::jobs, encode(jobs));
+            }
+         });
+         exploration.explore(instrumented_executable, job, worker_dir, job.size());
+         send_forwarded();
+         exploration.close(worker_dir);
+         send(out, message_t::done, {static_cast<int>(exploration.statistics().nr_explorations())});
+      }
+   }
+}
+
+} // end namespace detail
+
+//--------------------------------------------------------------------------------------------------
+
+
+/// @brief Explores the state-space of program with nr_workers worker processes, each owning the
+/// DFS stack of the subtrees it was handed. An idle worker is handed the unexplored alternatives
+/// at the shallowest level of a busy worker's stack (see depth_first_search::split).
+/// @details Every worker runs in its own directory output_dir/worker_<id>, which holds its
+/// records, its schedules.txt and a statistics.txt with one entry per job. The statistics over
+/// all workers are dumped to output_dir/statistics.txt. As every subtree is explored by exactly
+/// one worker, a complete parallel exploration sees as many executions as a serial one.
+/// max_nr_explorations is shared by the running jobs: a job is handed out with a share of the
+/// budget that no other job holds, and a worker that gives up subtrees gives up half of the
+/// budget it has left with them, so the workers explore at most max_nr_explorations executions.
+
+template <typename Mode, typename... Args>
+ExplorationStatistics run(const unsigned int nr_workers, const scheduler::program_t& program,
+                          const unsigned int max_nr_explorations, const Settings& settings,
+                          const std::string& optimization_level,
+                          const std::string& compiler_options,
+                          const boost::filesystem::path& output_dir, Args... args)
+{
+   if (boost::filesystem::exists(output_dir))
+      boost::filesystem::remove_all(output_dir);
+   boost::filesystem::create_directories(output_dir);
+   const auto output = boost::filesystem::absolute(output_dir);
+
+   const auto instrumented_executable =
+      boost::filesystem::absolute(exploration::detail::instrument(
+         program, output, optimization_level, compiler_options, settings.instrumentation_cache));
+
+   ExplorationStatistics statistics;
+   statistics.start_clock();
+   statistics.increase_nr_explorations(detail::coordinate(
+      nr_workers, {scheduler::schedule_t{}}, max_nr_explorations,
+      [&](const unsigned int id, const int in, const int out) {
+         detail::work<Mode>(in, out, program, instrumented_executable, settings,
+                            output / ("worker_" + std::to_string(id)), args...);
+      }));
+   statistics.stop_clock();
+   statistics.dump(output / "statistics.txt");
+   return statistics;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+
+/// @brief Samples the state-space of program with nr_workers worker processes, each running an
+/// Exploration<Mode> for its share of max_nr_explorations. Worker id constructs its Mode from
+/// args... followed by seed + id, so that every worker samples a different but reproducible
+/// sequence of schedules.
+/// @details As with run, worker id runs in output_dir/worker_<id> and the statistics over all
+/// workers are dumped to output_dir/statistics.txt, followed by those that Mode::merge_statistics
+/// merges from the worker directories. Samples are not split between workers.
+
+template <typename Mode, typename... Args>
+ExplorationStatistics sample(const unsigned int nr_workers, const scheduler::program_t& program,
+                             const unsigned int max_nr_explorations, const Settings& settings,
+                             const std::string& optimization_level,
+                             const std::string& compiler_options,
+                             const boost::filesystem::path& output_dir, const unsigned int seed,
+                             Args... args)
+{
+   if (boost::filesystem::exists(output_dir))
+      boost::filesystem::remove_all(output_dir);
+   boost::filesystem::create_directories(output_dir);
+   const auto output = boost::filesystem::absolute(output_dir);
+
+   const auto instrumented_executable =
+      boost::filesystem::absolute(exploration::detail::instrument(
+         program, output, optimization_level, compiler_options, settings.instrumentation_cache));
+
+   ExplorationStatistics statistics;
+   statistics.start_clock();
+   statistics.increase_nr_explorations(detail::coordinate(
+      nr_workers, std::deque<scheduler::schedule_t>(nr_workers), max_nr_explorations,
+      [&](const unsigned int id, const int in, const int out) {
+         const auto worker_dir = output / ("worker_" + std::to_string(id));
+         boost::filesystem::create_directories(worker_dir);
+         // The scheduler reads and writes its files relative to the current working directory
+         boost::filesystem::current_path(worker_dir);
+         const unsigned int share =
+            max_nr_explorations / nr_workers + (id < max_nr_explorations % nr_workers ? 1 : 0);
+         while (true)
+         {
+            const detail::message msg = detail::receive(in);
+            if (msg.type == detail::message_t::terminate)
+            {
+               return;
+            }
+            else if (msg.type == detail::message_t::steal)
+            {
+               detail::send(out, detail::message_t::jobs,
+                            detail::encode({scheduler::schedule_t{0}}));
+            }
+            else if (msg.type == detail::message_t::job)
+            {
+               const auto budget = static_cast<unsigned int>(detail::decode(msg.payload)[0][0]);
+               Exploration<Mode> exploration(program, std::min(share, budget), args..., seed + id);
+               exploration.set_settings(settings);
+               exploration.explore(instrumented_executable, {}, worker_dir);
+               exploration.close(worker_dir);
+               detail::send(out, detail::message_t::done,
+                            {static_cast<int>(exploration.statistics().nr_explorations())});
+            }
+         }
+      }));
+   statistics.stop_clock();
+   statistics.dump(output / "statistics.txt");
+   std::vector<boost::filesystem::path> worker_dirs;
+   for (unsigned int id = 0; id < nr_workers; ++id)
+      worker_dirs.push_back(output / ("worker_" + std::to_string(id)));
+   Mode::merge_statistics(worker_dirs, statistics.nr_explorations(), output / "statistics.txt");
+   return statistics;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace parallel
+} // end namespace exploration
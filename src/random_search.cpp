@@ -0,0 +1,324 @@
+
+#include "random_search.hpp"
+#include "checkpoint.hpp"
+#include "scheduler_input.hpp"
+
+// UTILS
+#include "color_output.hpp"
+#include "utils_io.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace exploration
+{
+//--------------------------------------------------------------------------------------------------
+
+random_search_statistics::random_search_statistics()
+: mNrDistinctSchedules(0)
+, mNrDuplicateSchedules(0) { }
+
+//--------------------------------------------------------------------------------------------------
+
+random_search_statistics::random_search_statistics(const unsigned int nr_distinct_schedules,
+                                                   const unsigned int nr_duplicate_schedules)
+: mNrDistinctSchedules(nr_distinct_schedules)
+, mNrDuplicateSchedules(nr_duplicate_schedules) { }
+
+//--------------------------------------------------------------------------------------------------
+
+unsigned int random_search_statistics::nr_distinct_schedules() const
+{
+   return mNrDistinctSchedules;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search_statistics::increase_nr_distinct_schedules()
+{
+   ++mNrDistinctSchedules;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+unsigned int random_search_statistics::nr_duplicate_schedules() const
+{
+   return mNrDuplicateSchedules;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search_statistics::increase_nr_duplicate_schedules()
+{
+   ++mNrDuplicateSchedules;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::ostream& operator<<(std::ostream& os, const random_search_statistics& stats)
+{
+   os << "nr_distinct_schedules\t" << stats.nr_distinct_schedules() << std::endl;
+   os << "nr_duplicate_schedules\t" << stats.nr_duplicate_schedules() << std::endl;
+   return os;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+random_search::random_search(const execution_t& execution, const strategy_t strategy,
+                             const unsigned int depth, const unsigned int seed)
+: mStrategy(strategy)
+, mGenerator(seed)
+, mDepth(depth)
+, mLength(0)
+, mSamples()
+, mHashes()
+, mStatistics()
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const std::string random_search::name = "random_search";
+
+//--------------------------------------------------------------------------------------------------
+
+scheduler::SchedulerSettings random_search::scheduler_settings() const
+{
+   return scheduler::SchedulerSettings(mStrategy == strategy_t::pct ? "PCT" : "UniformRandom");
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::write_scheduler_files()
+{
+   std::ostringstream os;
+   os << mGenerator();
+   if (mStrategy == strategy_t::pct)
+   {
+      os << " " << mDepth << " " << mLength;
+   }
+   scheduler::input::write(scheduler::input::random, os.str());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::update_statistics(const execution_t& execution)
+{
+   add_sample(execution);
+   std::size_t hash = 0;
+   for (const auto& transition : execution)
+   {
+      const auto tid = boost::apply_visitor(program_model::get_tid(), transition.instr());
+      boost::hash_combine(hash, tid);
+   }
+   if (mHashes.insert(hash).second)
+   {
+      mStatistics.increase_nr_distinct_schedules();
+   }
+   else
+   {
+      mStatistics.increase_nr_duplicate_schedules();
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::update_state(const execution_t& execution, const transition_t& transition)
+{
+   mLength = std::max<std::size_t>(mLength, transition.index());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+scheduler::schedule_t random_search::new_schedule(execution_t& execution,
+                                                  scheduler::schedule_t& schedule)
+{
+   if (mSamples.empty() || mSamples[0].exhausted)
+   {
+      return {};
+   }
+   scheduler::schedule_t prefix;
+   std::size_t state = 0;
+   while (true)
+   {
+      // A state that is not exhausted has an enabled thread to a successor that is not
+      const auto tids = unexhausted(state);
+      std::uniform_int_distribution<std::size_t> distribution(0, tids.size() - 1);
+      const auto tid = tids[distribution(mGenerator)];
+      prefix.push_back(tid);
+      const auto successor = mSamples[state].successors.find(tid);
+      if (mStrategy == strategy_t::pct || successor == mSamples[state].successors.end())
+      {
+         break;
+      }
+      state = successor->second;
+   }
+   DEBUGF(outputname(), "new_schedule", "", prefix << "\n");
+   return prefix;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::add_sample(const execution_t& execution)
+{
+   if (mSamples.empty())
+   {
+      mSamples.emplace_back();
+   }
+   std::vector<std::size_t> path{0};
+   for (const auto& transition : execution)
+   {
+      const auto tid = boost::apply_visitor(program_model::get_tid(), transition.instr());
+      mSamples[path.back()].enabled = tid_set(transition.pre().enabled());
+      const auto successor = mSamples[path.back()].successors.find(tid);
+      if (successor != mSamples[path.back()].successors.end())
+      {
+         path.push_back(successor->second);
+      }
+      else
+      {
+         mSamples[path.back()].successors.emplace(tid, mSamples.size());
+         path.push_back(mSamples.size());
+         mSamples.emplace_back();
+      }
+   }
+   // Replaying the schedule of execution ends in the same final state
+   mSamples[path.back()].exhausted = true;
+   path.pop_back();
+   for (; !path.empty() && unexhausted(path.back()).empty(); path.pop_back())
+   {
+      mSamples[path.back()].exhausted = true;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::vector<random_search::tid_t> random_search::unexhausted(const std::size_t state) const
+{
+   std::vector<tid_t> tids;
+   for (const auto tid : mSamples[state].enabled)
+   {
+      const auto successor = mSamples[state].successors.find(tid);
+      if (successor == mSamples[state].successors.end() || !mSamples[successor->second].exhausted)
+      {
+         tids.push_back(tid);
+      }
+   }
+   return tids;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::save(std::ostream& os) const
+{
+   std::ostringstream generator;
+   generator << mGenerator;
+   checkpoint::write_string(os, generator.str());
+   checkpoint::write<std::uint64_t>(os, mLength);
+   checkpoint::write<std::uint64_t>(os, mSamples.size());
+   for (const auto& state : mSamples)
+   {
+      checkpoint::write_tids(os, state.enabled);
+      checkpoint::write<std::uint8_t>(os, state.exhausted);
+      checkpoint::write<std::uint64_t>(os, state.successors.size());
+      for (const auto& successor : state.successors)
+      {
+         checkpoint::write<std::int32_t>(os, successor.first);
+         checkpoint::write<std::uint64_t>(os, successor.second);
+      }
+   }
+   checkpoint::write<std::uint64_t>(os, mHashes.size());
+   for (const auto& hash : mHashes)
+   {
+      checkpoint::write<std::uint64_t>(os, hash);
+   }
+   checkpoint::write<std::uint32_t>(os, mStatistics.nr_distinct_schedules());
+   checkpoint::write<std::uint32_t>(os, mStatistics.nr_duplicate_schedules());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::restore(std::istream& is)
+{
+   std::istringstream generator(checkpoint::read_string(is));
+   generator >> mGenerator;
+   mLength = checkpoint::read<std::uint64_t>(is);
+   mSamples.resize(checkpoint::read<std::uint64_t>(is));
+   for (auto& state : mSamples)
+   {
+      state.enabled = checkpoint::read_tids<tid_set>(is);
+      state.exhausted = checkpoint::read<std::uint8_t>(is) != 0;
+      state.successors.clear();
+      for (auto nr_successors = checkpoint::read<std::uint64_t>(is); nr_successors > 0;
+           --nr_successors)
+      {
+         const auto tid = checkpoint::read<std::int32_t>(is);
+         state.successors.emplace(tid, checkpoint::read<std::uint64_t>(is));
+      }
+   }
+   mHashes.clear();
+   for (auto nr_hashes = checkpoint::read<std::uint64_t>(is); nr_hashes > 0; --nr_hashes)
+   {
+      mHashes.insert(checkpoint::read<std::uint64_t>(is));
+   }
+   const auto nr_distinct_schedules = checkpoint::read<std::uint32_t>(is);
+   mStatistics =
+      random_search_statistics(nr_distinct_schedules, checkpoint::read<std::uint32_t>(is));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::close(const std::string& statistics_file) const
+{
+   utils::io::write_to_file(statistics_file, mStatistics, std::ios::app);
+   const auto hashes_file =
+      boost::filesystem::path(statistics_file).parent_path() / "schedule_hashes.txt";
+   std::ofstream ofs(hashes_file.string(), std::ios::app);
+   for (const auto& hash : mHashes)
+   {
+      ofs << hash << std::endl;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void random_search::merge_statistics(const std::vector<boost::filesystem::path>& worker_dirs,
+                                     const unsigned int nr_explorations,
+                                     const boost::filesystem::path& statistics_file)
+{
+   std::unordered_set<std::size_t> hashes;
+   for (const auto& worker_dir : worker_dirs)
+   {
+      std::ifstream ifs((worker_dir / "schedule_hashes.txt").string());
+      std::copy(std::istream_iterator<std::size_t>(ifs), std::istream_iterator<std::size_t>(),
+                std::inserter(hashes, hashes.end()));
+   }
+   const auto nr_distinct_schedules = static_cast<unsigned int>(hashes.size());
+   utils::io::write_to_file(
+      statistics_file.string(),
+      random_search_statistics(nr_distinct_schedules,
+                               nr_explorations - std::min(nr_explorations, nr_distinct_schedules)),
+      std::ios::app);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::string random_search::full_name()
+{
+   return name;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::string random_search::outputname()
+{
+   return text_color(name, utils::io::Color::BLUE);
+}
+
+//--------------------------------------------------------------------------------------------------
+} // end namespace exploration
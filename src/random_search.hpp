@@ -0,0 +1,202 @@
+#pragma once
+
+// SCHEDULER
+#include "schedule.hpp"
+#include "scheduler_settings.hpp"
+
+// EXPLORATION
+#include "tid_set.hpp"
+
+// PROGRAM_MODEL
+#include "execution.hpp"
+
+// UTILS
+#include "debug.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <map>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file random_search.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+namespace exploration
+{
+//--------------------------------------------------------------------------------------------------
+
+class random_search_statistics
+{
+public:
+
+   random_search_statistics();
+   random_search_statistics(const unsigned int nr_distinct_schedules,
+                            const unsigned int nr_duplicate_schedules);
+
+   /// @brief The number of explored schedules that were not explored before.
+   unsigned int nr_distinct_schedules() const;
+   void increase_nr_distinct_schedules();
+
+   unsigned int nr_duplicate_schedules() const;
+   void increase_nr_duplicate_schedules();
+
+private:
+
+   unsigned int mNrDistinctSchedules;
+   unsigned int mNrDuplicateSchedules;
+
+}; // end class random_search_statistics
+
+//--------------------------------------------------------------------------------------------------
+
+std::ostream& operator<<(std::ostream&, const random_search_statistics&);
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Samples the state-space instead of traversing it, for programs that are too large for
+/// depth_first_search. Every exploration runs the program under a schedule that is chosen by the
+/// scheduler's UniformRandom or PCT selection strategy, from a seed that write_scheduler_files
+/// draws from a generator seeded with the given seed. An exploration with the same seed hence
+/// yields the same sequence of schedules.
+/// @details With PCT, the scheduler runs the enabled thread with the highest priority, where the
+/// threads get random initial priorities and the priority of the running thread is lowered at
+/// depth-1 random steps (the change points) @cite Burckhardt:2010:RSP:1736020.1736040. The change
+/// points are drawn from the length of the longest execution seen so far.
+/// The explored schedules are kept in a tree, in which a state is exhausted once every schedule
+/// through it was explored. The prefix that new_schedule hands to the scheduler avoids the
+/// exhausted states. With uniform, the prefix ends in a state that was never explored, so every
+/// sample differs from the ones before it, and the search is done once every schedule was
+/// explored.
+/// @note With PCT, the priorities of the scheduler choose every step but the first, so only the
+/// first thread avoids the exhausted states, and a sample can repeat an earlier one. The hashes of
+/// the explored schedules count the distinct and duplicate samples.
+
+class random_search
+{
+public:
+
+   using execution_t = program_model::Execution;
+   using transition_t = typename execution_t::transition_t;
+
+   enum class strategy_t
+   {
+      uniform,
+      pct
+   };
+
+   //-----------------------------------------------------------------------------------------------
+
+   explicit random_search(const execution_t& execution, const strategy_t strategy,
+                          const unsigned int depth, const unsigned int seed);
+
+   //-----------------------------------------------------------------------------------------------
+
+   static const std::string name;
+
+   /// @brief Sets the selection strategy to UniformRandom or PCT.
+   scheduler::SchedulerSettings scheduler_settings() const;
+
+   /// @brief Hands a fresh seed (and the depth and the estimated length for PCT) to the next
+   /// replay through scheduler::input.
+   void write_scheduler_files();
+
+   /// @brief Returns true.
+   bool check_valid(const bool contains_locks) const { return true; }
+
+   /// @brief Does nothing.
+   inline void reset() { }
+
+   /// @brief Adds the schedule of execution to mSamples, and its hash to mHashes, counting it as
+   /// distinct or as duplicate.
+   void update_statistics(const execution_t& execution);
+
+   /// @brief Updates the estimated length of an execution.
+   void update_state(const execution_t& execution, const transition_t& transition);
+
+   /// @brief Returns the prefix of the next sample, after which the scheduler samples the rest.
+   /// Every step of the prefix is drawn uniformly from the enabled threads whose successor state
+   /// is not exhausted. With uniform, the prefix ends with the first step into a state that was
+   /// never explored, with PCT it is a single step. Returns an empty schedule, which stops the
+   /// Exploration, iff every schedule was explored.
+   scheduler::schedule_t new_schedule(execution_t& execution, scheduler::schedule_t& schedule);
+
+   /// @brief Does nothing, as there is no exploration tree to restrict.
+   void set_floor(const std::size_t) { }
+   std::size_t floor() const { return 0; }
+
+   /// @brief Returns no schedules, samples are not split between explorers.
+   std::vector<scheduler::schedule_t> split(const execution_t&, const scheduler::schedule_t&)
+   {
+      return {};
+   }
+
+   /// @brief Writes the state of mGenerator, mLength, mSamples, mHashes and mStatistics to a
+   /// checkpoint.
+   void save(std::ostream& os) const;
+
+   /// @brief Restores the state written by save.
+   void restore(std::istream& is);
+
+   /// @brief Appends mStatistics to statistics_file and mHashes to schedule_hashes.txt in the
+   /// same directory.
+   void close(const std::string& statistics_file) const;
+
+   /// @brief Appends the random_search_statistics over the schedule_hashes.txt of all
+   /// worker_dirs to statistics_file, where a schedule that several workers sampled is distinct
+   /// once. Every other exploration of the nr_explorations in total is a duplicate.
+   static void merge_statistics(const std::vector<boost::filesystem::path>& worker_dirs,
+                                const unsigned int nr_explorations,
+                                const boost::filesystem::path& statistics_file);
+
+   /// @brief Does nothing.
+   void dump_state(std::ostream& os, const std::size_t index) const { }
+
+   static std::string full_name();
+
+   const random_search_statistics& statistics() const { return mStatistics; }
+
+private:
+
+   using tid_t = program_model::Thread::tid_t;
+
+   /// @brief A state in the tree of the explored schedules.
+   struct sample_state
+   {
+      tid_set enabled;
+      /// @brief The indices in mSamples of the explored successors, by the thread taken to them.
+      std::map<tid_t, std::size_t> successors;
+      /// @brief Whether every schedule through this state was explored.
+      bool exhausted = false;
+   };
+
+   static std::string outputname();
+
+   /// @brief Adds the schedule of execution to mSamples and marks the states that it exhausts.
+   void add_sample(const execution_t& execution);
+
+   /// @brief Returns the enabled threads of mSamples[state] whose successor is not exhausted.
+   std::vector<tid_t> unexhausted(const std::size_t state) const;
+
+   strategy_t mStrategy;
+   std::mt19937_64 mGenerator;
+   unsigned int mDepth;
+
+   /// @brief The length of the longest execution explored so far.
+   std::size_t mLength;
+
+   /// @brief The tree of the explored schedules, rooted at mSamples[0] once the first execution
+   /// was explored.
+   std::vector<sample_state> mSamples;
+
+   std::unordered_set<std::size_t> mHashes;
+   random_search_statistics mStatistics;
+
+}; // end class random_search
+
+//--------------------------------------------------------------------------------------------------
+} // end namespace exploration
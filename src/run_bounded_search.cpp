@@ -4,11 +4,15 @@
 #include "depth_first_search.hpp"
 #include "dpor.hpp"
 #include "exploration.hpp"
+#include "iterative_deepening.hpp"
 #include "options.hpp"
+#include "parallel_exploration.hpp"
 
 namespace exploration {
 template <typename bound_function_t>
-using bounded_search = Exploration<depth_first_search<bound<bound_function_t>>>;
+using bounded_search_mode = depth_first_search<bound<bound_function_t>>;
+template <typename bound_function_t>
+using bounded_search = Exploration<bounded_search_mode<bound_function_t>>;
 }
 
 int main(int argc, char* argv[])
@@ -30,6 +34,10 @@ int main(int argc, char* argv[])
 
       const std::string bound_function = options.map()["bound-function"].as<std::string>();
       const unsigned int bound = options.map()["bound"].as<unsigned int>();
+      const unsigned int nr_workers = options.map()["workers"].as<unsigned int>();
+      const bool iterative = options.map()["iterative"].as<bool>();
+      const auto settings = state_space_explorer::get_settings(options, nr_workers == 1 && !iterative);
+      state_space_explorer::check_checkpoint_options(options, nr_workers == 1 && !iterative);
 
       boost::filesystem::path output_dir;
       try
@@ -41,12 +49,35 @@ int main(int argc, char* argv[])
          output_dir = "./statespace_explorer_output" / required.first.filename() / "bounded";
       }
 
-      if (bound_function == "preemptions")
+      if (iterative && nr_workers > 1)
+      {
+         std::cout << "iterative exploration requires workers 1\n";
+         return 1;
+      }
+      else if (bound_function == "preemptions" && iterative)
+      {
+         exploration::iterative_deepening<bound_functions::Preemptions>(
+            required.first, required.second, bound, settings, optimization_level,
+            compiler_options,
+            output_dir.string() + "-preemptions-iterative-" + std::to_string(bound));
+         return 0;
+      }
+      else if (bound_function == "preemptions" && nr_workers > 1)
+      {
+         using mode_t = exploration::bounded_search_mode<bound_functions::Preemptions>;
+         exploration::parallel::run<mode_t>(
+            nr_workers, required.first, required.second, settings, optimization_level,
+            compiler_options,
+            output_dir.string() + "-preemptions-" + std::to_string(bound), bound);
+         return 0;
+      }
+      else if (bound_function == "preemptions")
       {
          exploration::bounded_search<bound_functions::Preemptions> bs(required.first,
                                                                       required.second, bound);
-         bs.run({}, optimization_level, compiler_options,
-                output_dir.string() + "-preemptions-" + std::to_string(bound));
+         bs.set_settings(settings);
+         state_space_explorer::run_or_resume(
+            bs, options, output_dir.string() + "-preemptions-" + std::to_string(bound));
          return 0;
       }
       else
@@ -4,6 +4,7 @@
 #include "depth_first_search.hpp"
 #include "exploration.hpp"
 #include "options.hpp"
+#include "parallel_exploration.hpp"
 
 #include <iostream>
 #include <limits>
@@ -25,6 +26,9 @@ int main(int argc, char* argv[])
 
       const std::string optimization_level = options.map()["opt"].as<std::string>();
       const std::string compiler_options = options.map()["c"].as<std::string>();
+      const unsigned int nr_workers = options.map()["workers"].as<unsigned int>();
+      const auto settings = state_space_explorer::get_settings(options, nr_workers == 1);
+      state_space_explorer::check_checkpoint_options(options, nr_workers == 1);
 
       boost::filesystem::path output_dir;
       try
@@ -37,10 +41,19 @@ int main(int argc, char* argv[])
       }
 
       using namespace exploration;
-      using dfs_t = Exploration<depth_first_search<bound<bound_functions::Preemptions>>>;
+      using mode_t = depth_first_search<bound<bound_functions::Preemptions>>;
 
-      dfs_t dfs(required.first, required.second, std::numeric_limits<int>::max());
-      dfs.run({}, optimization_level, compiler_options, output_dir);
+      if (nr_workers > 1)
+      {
+         parallel::run<mode_t>(nr_workers, required.first, required.second, settings,
+                               optimization_level, compiler_options, output_dir,
+                               std::numeric_limits<int>::max());
+         return 0;
+      }
+
+      Exploration<mode_t> dfs(required.first, required.second, std::numeric_limits<int>::max());
+      dfs.set_settings(settings);
+      state_space_explorer::run_or_resume(dfs, options, output_dir);
 
       return 0;
    }
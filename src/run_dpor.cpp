@@ -1,11 +1,14 @@
 
+#include "bound_functions/preemptions.hpp"
 #include "dependence.hpp"
 #include "depth_first_search.hpp"
 #include "dpor.hpp"
 #include "exploration.hpp"
 #include "happens_before.hpp"
 #include "options.hpp"
+#include "parallel_exploration.hpp"
 #include "sufficient_sets/bound_persistent_set.hpp"
+#include "sufficient_sets/optimal_set.hpp"
 #include "sufficient_sets/persistent_set.hpp"
 #include "sufficient_sets/source_set.hpp"
 
@@ -17,6 +20,26 @@ template <typename sufficient_set_t>
 using dpor_t = Exploration<depth_first_search<dpor<sufficient_set_t>>>;
 
 
+namespace {
+
+BoundPersistentOptimizations get_bound_persistent_optimizations(
+   const state_space_explorer::options& options)
+{
+   const std::string& sleepsets = options.map()["bound-sleepsets"].as<std::string>();
+   if (sleepsets != "never" && sleepsets != "conservative")
+   {
+      throw std::invalid_argument("bound-sleepsets has to be in { never, conservative }");
+   }
+   return BoundPersistentOptimizations(
+      options.map()["bound-transitive-reduction"].as<bool>(),
+      options.map()["bound-alternative-thread"].as<bool>(), options.map()["bound-opt"].as<bool>(),
+      sleepsets == "never" ? BoundPersistentOptimizations::NEVER
+                           : BoundPersistentOptimizations::CONSERVATIVE);
+}
+
+} // end namespace
+
+
 int main(int argc, char* argv[])
 {
    state_space_explorer::options options;
@@ -35,6 +58,11 @@ int main(int argc, char* argv[])
       const std::string compiler_options = options.map()["c"].as<std::string>();
 
       const std::string& sufficient_set = options.map()["sufficient-set"].as<std::string>();
+      const unsigned int nr_workers = options.map()["workers"].as<unsigned int>();
+      // Optimal does not support checkpoints
+      const Settings settings = state_space_explorer::get_settings(
+         options, nr_workers == 1 && sufficient_set != "optimal");
+      state_space_explorer::check_checkpoint_options(options, nr_workers == 1);
 
       boost::filesystem::path output_dir;
       try
@@ -46,15 +74,64 @@ int main(int argc, char* argv[])
          output_dir = "./statespace_explorer_output" / required.first.filename() / "dpor";
       }
 
-      if (sufficient_set == "persistent")
+      if (sufficient_set == "persistent" && nr_workers > 1)
+      {
+         parallel::run<depth_first_search<dpor<Persistent>>>(
+            nr_workers, required.first, required.second, settings, optimization_level,
+            compiler_options, output_dir, settings);
+         return 0;
+      }
+      else if (nr_workers > 1)
+      {
+         std::cout << "parallel exploration requires sufficient-set persistent\n";
+         return 1;
+      }
+      else if (sufficient_set == "persistent")
+      {
+         dpor_t<Persistent> explorer(required.first, required.second, settings);
+         explorer.set_settings(settings);
+         state_space_explorer::run_or_resume(explorer, options, output_dir);
+         return 0;
+      }
+      else if (sufficient_set == "source")
+      {
+         dpor_t<Source> explorer(required.first, required.second, settings);
+         explorer.set_settings(settings);
+         state_space_explorer::run_or_resume(explorer, options, output_dir);
+         return 0;
+      }
+      else if (sufficient_set == "optimal")
+      {
+         if (options.map().count("checkpoint-interval") || options.map().count("resume"))
+         {
+            std::cout << "sufficient-set optimal does not support checkpoint-interval and resume\n";
+            return 1;
+         }
+         dpor_t<Optimal> explorer(required.first, required.second, settings);
+         explorer.set_settings(settings);
+         state_space_explorer::run_or_resume(explorer, options, output_dir);
+         return 0;
+      }
+      else if (sufficient_set == "bound-persistent")
       {
-         dpor_t<Persistent>(required.first, required.second)
-            .run({}, optimization_level, compiler_options, output_dir);
+         if (options.map()["bound-function"].as<std::string>() != "preemptions")
+         {
+            std::cout << "bound_function has to be in { preemptions }\n";
+            return 1;
+         }
+         const unsigned int bound = options.map()["bound"].as<unsigned int>();
+         const auto optimizations = get_bound_persistent_optimizations(options);
+         dpor_t<BoundPersistent<bound_functions::Preemptions>> explorer(
+            required.first, required.second, settings, bound, optimizations);
+         explorer.set_settings(settings);
+         state_space_explorer::run_or_resume(explorer, options,
+                                             output_dir.string() + "-preemptions-" +
+                                                std::to_string(bound) + "-" + optimizations.path());
          return 0;
       }
       else
       {
-         std::cout << "mode has to be in { persistent }\n";
+         std::cout << "mode has to be in { persistent, source, optimal, bound-persistent }\n";
          return 1;
       }
    }
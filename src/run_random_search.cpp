@@ -0,0 +1,78 @@
+
+#include "exploration.hpp"
+#include "options.hpp"
+#include "parallel_exploration.hpp"
+#include "random_search.hpp"
+
+#include <iostream>
+
+
+int main(int argc, char* argv[])
+{
+   state_space_explorer::options options;
+   try
+   {
+      options.parse(argc, argv);
+      if (options.map().count("h"))
+      {
+         std::cout << options << "\n";
+         return 0;
+      }
+
+      const auto required = state_space_explorer::get_required_options(options);
+
+      const std::string optimization_level = options.map()["opt"].as<std::string>();
+      const std::string compiler_options = options.map()["c"].as<std::string>();
+      const unsigned int nr_workers = options.map()["workers"].as<unsigned int>();
+      const std::string strategy = options.map()["strategy"].as<std::string>();
+      const unsigned int depth = options.map()["depth"].as<unsigned int>();
+      const unsigned int seed = options.map()["seed"].as<unsigned int>();
+      const auto settings = state_space_explorer::get_settings(options, nr_workers == 1);
+      state_space_explorer::check_checkpoint_options(options, nr_workers == 1);
+
+      boost::filesystem::path output_dir;
+      try
+      {
+         output_dir = options.map()["o"].as<std::string>();
+      }
+      catch (const std::exception&)
+      {
+         output_dir = "./statespace_explorer_output" / required.first.filename() / "random";
+      }
+
+      using namespace exploration;
+
+      if (strategy != "uniform" && strategy != "pct")
+      {
+         std::cout << "strategy has to be in { uniform, pct }\n";
+         return 1;
+      }
+      const auto strategy_value =
+         strategy == "pct" ? random_search::strategy_t::pct : random_search::strategy_t::uniform;
+      output_dir = output_dir.string() + "-" + strategy + "-" + std::to_string(seed);
+
+      if (nr_workers > 1)
+      {
+         parallel::sample<random_search>(nr_workers, required.first, required.second, settings,
+                                         optimization_level, compiler_options, output_dir, seed,
+                                         strategy_value, depth);
+         return 0;
+      }
+
+      Exploration<random_search> random(required.first, required.second, strategy_value, depth,
+                                        seed);
+      random.set_settings(settings);
+      state_space_explorer::run_or_resume(random, options, output_dir);
+
+      return 0;
+   }
+   catch (const std::invalid_argument& ex)
+   {
+      std::cout << ex.what() << "\n\n" << options << "\n";
+   }
+   catch (const boost::program_options::invalid_option_value&)
+   {
+      std::cout << "Please run State-Space Explorer with valid options\n" << options << "\n";
+      return 1;
+   }
+}
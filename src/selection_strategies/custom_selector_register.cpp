@@ -2,7 +2,9 @@
 #include "custom_selector_register.hpp"
 #include "error.hpp"
 #include "non_preemptive.hpp"
+#include "pct.hpp"
 #include "sleep_sets.hpp"
+#include "uniform_random.hpp"
 
 namespace scheduler
 {
@@ -10,6 +12,10 @@ namespace scheduler
     {
         if (tag == "SleepSets") {
             return std::make_unique<Selector<SleepSets>>();
+        } else if (tag == "UniformRandom") {
+            return std::make_unique<Selector<UniformRandom>>();
+        } else if (tag == "PCT") {
+            return std::make_unique<Selector<PCT>>();
         } else {
             ERROR("custom_selector_factory", "no selector registered under " << tag);
             return std::make_unique<Selector<NonPreemptive>>();
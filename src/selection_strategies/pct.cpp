@@ -0,0 +1,65 @@
+
+#include "pct.hpp"
+#include "scheduler_input.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <limits>
+
+namespace scheduler
+{
+	PCT::PCT()
+	: mGenerator()
+	, mDepth(1)
+	, mChangePoints()
+	, mPriorities()
+	, mAlternative()
+	{
+		std::mt19937_64::result_type seed = 0;
+		unsigned int length = 0;
+		*input::read(input::random, "schedules/random.txt") >> seed >> mDepth >> length;
+		mGenerator.seed(seed);
+		if (length > 0) {
+			std::uniform_int_distribution<unsigned int> distribution(1, length);
+			for (unsigned int i = 1; i < mDepth; ++i) {
+				mChangePoints.push_back(distribution(mGenerator));
+			}
+		}
+	}
+	
+	/**
+	 @brief Applies the change point at task_nr (if any) to the Thread that
+	 executed the last step and lets NonPreemptive select the Thread with
+	 the highest priority in the given selection.
+	 */
+	PCT::result_t PCT::select(
+		const TaskPool& pool, const Tids& selection, const unsigned int task_nr)
+	{
+		/// @pre !selection.empty
+		assert(!selection.empty());
+		if (task_nr > 0) {
+			const auto last = boost::apply_visitor(program_model::get_tid(), *pool.current_task());
+			for (unsigned int i = 0; i < mChangePoints.size(); ++i) {
+				if (mChangePoints[i] == task_nr) {
+					mPriorities[last] = i + 1;
+				}
+			}
+		}
+		const auto tid = *std::max_element(
+			selection.begin(), selection.end(),
+			[this] (const auto& lhs, const auto& rhs) { return priority(lhs) < priority(rhs); }
+		);
+		return mAlternative.select(pool, Tids{ tid }, task_nr);
+	}
+	
+	unsigned long PCT::priority(const Thread::tid_t& tid)
+	{
+		auto it = mPriorities.find(tid);
+		if (it == mPriorities.end()) {
+			std::uniform_int_distribution<unsigned long> distribution(
+				mDepth, std::numeric_limits<unsigned long>::max());
+			it = mPriorities.emplace(tid, distribution(mGenerator)).first;
+		}
+		return it->second;
+	}
+} // end namespace scheduler
@@ -0,0 +1,68 @@
+
+#ifndef PCT_HPP_INCLUDED
+#define PCT_HPP_INCLUDED
+
+#include "execution.hpp"
+#include "non_preemptive.hpp"
+
+#include <map>
+#include <random>
+#include <vector>
+
+/*---------------------------------------------------------------------------75*/
+/**
+ @file pct.hpp
+ @brief Definition of class PCT.
+ @author Susanne van den Elsen
+ @date 2017
+ */
+/*---------------------------------------------------------------------------++*/
+
+using namespace program_model;
+
+namespace scheduler
+{
+	/**
+	 @brief Probabilistic Concurrency Testing with depth d
+	 @cite Burckhardt:2010:RSP:1736020.1736040.
+	 @details Reads a seed, d and the estimated number of steps k from
+	 scheduler::input::random. Threads get distinct random priorities >= d when
+	 they are first seen, and at d-1 change points drawn from [1,k] the
+	 priority of the Thread that executed the last step is lowered to the
+	 number of the change point. Selects the Thread with the highest
+	 priority.
+	 */
+	class PCT
+	{
+	public:
+		
+		using result_t = std::pair<Execution::Status,Thread::tid_t>;
+		
+		PCT();
+		
+		result_t select(const TaskPool& pool, const Tids& selection, const unsigned int task_nr);
+		
+	private:
+		
+		// DATA MEMBERS
+		
+		std::mt19937_64 mGenerator;
+		unsigned int mDepth;
+		
+		/**
+		 @brief mChangePoints[i] is the step at which the priority of the
+		 Thread that executed the last step is lowered to i+1.
+		 */
+		std::vector<unsigned int> mChangePoints;
+		
+		std::map<Thread::tid_t,unsigned long> mPriorities;
+		NonPreemptive mAlternative;
+		
+		// HELPER FUNCTIONS
+		
+		unsigned long priority(const Thread::tid_t& tid);
+		
+	}; // end class PCT
+} // end namespace scheduler
+
+#endif
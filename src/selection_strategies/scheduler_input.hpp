@@ -0,0 +1,62 @@
+
+#ifndef SCHEDULER_INPUT_HPP_INCLUDED
+#define SCHEDULER_INPUT_HPP_INCLUDED
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+/*---------------------------------------------------------------------------75*/
+/**
+ @file scheduler_input.hpp
+ @brief Handoff of the explorer's per-replay input to the selection
+ strategies.
+ @author Susanne van den Elsen
+ @date 2017
+ */
+/*---------------------------------------------------------------------------++*/
+
+namespace scheduler
+{
+namespace input
+{
+	/**
+	 @brief The sleepset that SleepSets starts from, and the seed (with the
+	 depth and length for PCT) that UniformRandom and PCT start from. The
+	 explorer puts them in its environment, from which every replay it
+	 starts inherits them. Nothing is written to the working directory, so
+	 explorations that share a directory do not overwrite each other's
+	 input.
+	 */
+	const std::string sleepset = "STATE_SPACE_EXPLORER_SLEEPSET";
+	const std::string random = "STATE_SPACE_EXPLORER_RANDOM";
+
+	/**
+	 @brief Hands the textual representation of object under name to the
+	 replays started after this call.
+	 */
+	template <typename T>
+	void write(const std::string& name, const T& object)
+	{
+		std::ostringstream os;
+		os << object;
+		setenv(name.c_str(), os.str().c_str(), 1);
+	}
+
+	/**
+	 @brief Returns a stream over the input handed over under name or, for
+	 a program that was not started by an explorer, over file.
+	 */
+	inline std::unique_ptr<std::istream> read(const std::string& name, const std::string& file)
+	{
+		if (const char* value = std::getenv(name.c_str())) {
+			return std::make_unique<std::istringstream>(value);
+		}
+		return std::make_unique<std::ifstream>(file);
+	}
+} // end namespace input
+} // end namespace scheduler
+
+#endif
@@ -1,12 +1,12 @@
 
 #include "sleep_sets.hpp"
+#include "scheduler_input.hpp"
 
 #include <visible_instruction_io.hpp>
 
 #include <container_output.hpp>
 
 #include <assert.h>
-#include <fstream>
 
 namespace scheduler
 {
@@ -39,9 +39,7 @@ namespace scheduler
 	
 	void SleepSets::initialize()
 	{
-		std::ifstream ifs("schedules/sleepset.txt");
-		ifs >> mSleep;
-		ifs.close();
+		*input::read(input::sleepset, "schedules/sleepset.txt") >> mSleep;
 		DEBUGF("SleepSets", "initialize", "", "mSleep = " << mSleep << "\n");
 	}
 	
@@ -0,0 +1,32 @@
+
+#include "uniform_random.hpp"
+#include "scheduler_input.hpp"
+
+#include <assert.h>
+#include <iterator>
+
+namespace scheduler
+{
+	UniformRandom::UniformRandom()
+	: mGenerator()
+	, mAlternative()
+	{
+		std::mt19937_64::result_type seed = 0;
+		*input::read(input::random, "schedules/random.txt") >> seed;
+		mGenerator.seed(seed);
+	}
+	
+	/**
+	 @brief Draws a Thread from the given selection and lets NonPreemptive
+	 select it, such that the result has the status NonPreemptive gives.
+	 */
+	UniformRandom::result_t UniformRandom::select(
+		const TaskPool& pool, const Tids& selection, const unsigned int task_nr)
+	{
+		/// @pre !selection.empty
+		assert(!selection.empty());
+		std::uniform_int_distribution<std::size_t> distribution(0, selection.size()-1);
+		const auto tid = *std::next(selection.begin(), distribution(mGenerator));
+		return mAlternative.select(pool, Tids{ tid }, task_nr);
+	}
+} // end namespace scheduler
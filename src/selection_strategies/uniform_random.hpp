@@ -0,0 +1,47 @@
+
+#ifndef UNIFORM_RANDOM_HPP_INCLUDED
+#define UNIFORM_RANDOM_HPP_INCLUDED
+
+#include "execution.hpp"
+#include "non_preemptive.hpp"
+
+#include <random>
+
+/*---------------------------------------------------------------------------75*/
+/**
+ @file uniform_random.hpp
+ @brief Definition of class UniformRandom.
+ @author Susanne van den Elsen
+ @date 2017
+ */
+/*---------------------------------------------------------------------------++*/
+
+using namespace program_model;
+
+namespace scheduler
+{
+	/**
+	 @brief Selects a Thread uniformly at random from the selection, using
+	 the seed handed over through scheduler::input.
+	 */
+	class UniformRandom
+	{
+	public:
+		
+		using result_t = std::pair<Execution::Status,Thread::tid_t>;
+		
+		UniformRandom();
+		
+		result_t select(const TaskPool& pool, const Tids& selection, const unsigned int task_nr);
+		
+	private:
+		
+		// DATA MEMBERS
+		
+		std::mt19937_64 mGenerator;
+		NonPreemptive mAlternative;
+		
+	}; // end class UniformRandom
+} // end namespace scheduler
+
+#endif
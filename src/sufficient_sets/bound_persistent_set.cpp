@@ -1,5 +1,6 @@
 
 #include "bound_persistent_set.hpp"
+#include "checkpoint.hpp"
 #include "utils_io.hpp"
 
 namespace exploration
@@ -14,16 +15,12 @@ namespace exploration
         mPending.insert(tid);
     }
     
-    void BoundPersistentState::add_to_pending(const Tids& tids)
+    void BoundPersistentState::add_to_pending(const tid_set& tids)
     {
-        std::set_union(
-            mPending.begin(), mPending.end(),
-            tids.begin(), tids.end(),
-            std::inserter(mPending, mPending.end())
-        );
+        mPending |= tids;
     }
     
-    const Tids& BoundPersistentState::pending() const
+    const tid_set& BoundPersistentState::pending() const
     {
         return mPending;
     }
@@ -92,26 +89,35 @@ namespace exploration
 	{
 		std::string path{};
 		path += (mTRANSITIVE_REDUCTION ? "TR" : "tr");
-		path += (mALTERNATIVE_THREAD ? "-ALT" : "alt");
-		path += (mBOUND_OPT ? "-B" : "b");
+		path += (mALTERNATIVE_THREAD ? "-ALT" : "-alt");
+		path += (mBOUND_OPT ? "-B" : "-b");
 		if (mSLEEPSETS == NEVER)              { path += "-sNEV";    }
 		else if (mSLEEPSETS == CONSERVATIVE)  { path += "-sCONS";   }
 		return path;
 	}
 	
-	BoundPersistentBase::BoundPersistentBase()
+	std::string BoundPersistentBase::name()
+	{
+		return "BoundPersistent";
+	}
+	
+	BoundPersistentBase::BoundPersistentBase(const BoundPersistentOptimizations& opt)
 	: mState({ BoundPersistentState() })
- 	, mOpt() { }
+ 	, mOpt(opt) { }
 	
-	void BoundPersistentBase::add_to_pool(Tids& pool) const
+	void BoundPersistentBase::add_to_pool(tid_set& pool, const std::size_t index) const
 	{
-		if (mState.back().bound_exceeded()) {
-			for (const auto& pending : mState.back().pending()) {
-				pool.insert(pending);
-			}
+		if (mState[index].bound_exceeded()) {
+			pool |= mState[index].pending();
 		}
 	}
 	
+	std::vector<Thread::tid_t> BoundPersistentBase::wakeup_sequence(
+		const State&, const Thread::tid_t&, SleepSet&)
+	{
+		return {};
+	}
+	
 	void BoundPersistentBase::update_after_exploration(const transition& t, SufficientSet& t_pre)
 	{
 		/// @pre mState.size() == t.index()+1 (i.e. did not yet pop_back())
@@ -137,6 +143,28 @@ namespace exploration
 		mState.pop_back();
 	}
 	
+	void BoundPersistentBase::save(std::ostream& os) const
+	{
+		checkpoint::write<std::uint64_t>(os, mState.size());
+		for (const auto& state : mState) {
+			checkpoint::write_tids(os, state.pending());
+			checkpoint::write<bool>(os, state.bound_exceeded());
+		}
+	}
+	
+	void BoundPersistentBase::restore(std::istream& is)
+	{
+		checkpoint::check_depth(checkpoint::read<std::uint64_t>(is), mState.size());
+		for (auto& state : mState) {
+			BoundPersistentState restored(state.bound_value());
+			restored.add_to_pending(checkpoint::read_tids<tid_set>(is));
+			if (checkpoint::read<bool>(is)) {
+				restored.set_bound_exceeded();
+			}
+			state = restored;
+		}
+	}
+	
 	bool BoundPersistentBase::adding_condition(const State& s, const SufficientSet& suf, const Thread::tid_t& tid) const
 	{
 		if (mOpt.SLEEPSETS() == mOpt.sleep_t::NEVER) {
@@ -146,23 +174,21 @@ namespace exploration
 		}
 	}
 	
-	Tids BoundPersistentBase::adding_tids(const State& s, const SufficientSet& suf) const
+	tid_set BoundPersistentBase::adding_tids(const State& s, const SufficientSet& suf) const
 	{
 		if (mOpt.SLEEPSETS() == mOpt.sleep_t::NEVER) {
-			return s.enabled();
+			return tid_set(s.enabled());
 		} else {
-			return suf.sleepset().awake(s.enabled());
+			return suf.sleepset().awake(tid_set(s.enabled()));
 		}
 	}
 	
-	const std::string BoundPersistentBase::name = "BoundPersistent";
-	
 	const std::string BoundPersistentBase::tabs = "\t\t\t";
 	
 	std::string BoundPersistentBase::outputname()
 	{
 		std::string outputname = tabs;
-		outputname += text_color(name, utils::io::Color::GREEN);
+		outputname += text_color(name(), utils::io::Color::GREEN);
 		return outputname;
 	}
 	
@@ -30,8 +30,8 @@ namespace exploration
         //
         
         void add_to_pending(const Thread::tid_t& tid);
-        void add_to_pending(const Tids& tids);
-        const Tids& pending() const;
+        void add_to_pending(const tid_set& tids);
+        const tid_set& pending() const;
         
         void set_bound_exceeded();
         bool bound_exceeded() const;
@@ -42,7 +42,7 @@ namespace exploration
         
         // DATA MEMBERS
         
-        Tids mPending;
+        tid_set mPending;
         
         /**
          @brief Whether the bound was exceeded in the exploration subtree
@@ -87,6 +87,12 @@ namespace exploration
 		bool ALTERNATIVE_THREAD() const;
 		bool BOUND_OPT() const;
 		sleep_t SLEEPSETS() const;
+		
+		/**
+		 @brief Returns a short description of the optimizations that are
+		 turned on (upper case) and off (lower case), e.g. TR-ALT-B-sCONS.
+		 */
+		std::string path() const;
 				
 	private:
 		
@@ -134,6 +140,20 @@ namespace exploration
 		
 		//
 		
+		static std::string name();
+		
+		/**
+		 @brief update_after_exploration depends on the bound of the states
+		 of the explored execution, hence dpor replays every schedule.
+		 */
+		static constexpr bool prune_sleepset_blocked = false;
+		
+		/**
+		 @brief Adding a backtrack point depends on the bound of the current
+		 BoundPersistentState, hence no thread is skipped as unchanged.
+		 */
+		static constexpr bool skip_unchanged_threads = false;
+		
 		/**
 		 @brief Returns true.
 		 */
@@ -160,11 +180,11 @@ namespace exploration
 		 @endcode
 		 @see HappensBefore::max_dependent_per_thread
 		 */
-		template<typename Dependence>
+		template<typename Dependence, typename clock_t>
 		BacktrackPoints backtrack_points(
 			const execution& E,
 			const unsigned int index,
-			const HappensBefore<Dependence>& HB) const
+			const HappensBefore<Dependence, clock_t>& HB) const
 		{
 			DEBUGF(outputname(), "backtrack_points", to_short_string(E[index]), "\n");
 			BacktrackPoints Points{};
@@ -191,9 +211,16 @@ namespace exploration
 		}
 		
 		/**
-		 @brief Adds mState.back().pending() to pool.
+		 @brief Adds the pending set of the index'th state to pool, if the
+		 bound was exceeded there.
+		 */
+		void add_to_pool(tid_set& pool, const std::size_t index) const;
+		
+		/**
+		 @brief Returns an empty sequence.
 		 */
-		void add_to_pool(Tids& pool) const;
+		static std::vector<Thread::tid_t> wakeup_sequence(
+			const State&, const Thread::tid_t&, SleepSet&);
 		
 		/**
 		 @brief Propagates t.post.mBoundExceeded to t.pre.mBoundExceeded iff
@@ -204,9 +231,22 @@ namespace exploration
 		
 		void pop_back();
 		
+		/**
+		 @brief Writes the pending sets and bound_exceeded flags of mState
+		 to a checkpoint.
+		 */
+		void save(std::ostream& os) const;
+		
+		/**
+		 @brief Restores the state written by save, after update_state
+		 rebuilt mState along the branch that was current when the
+		 checkpoint was written.
+		 */
+		void restore(std::istream& is);
+		
 	protected:
 		
-		BoundPersistentBase();
+		explicit BoundPersistentBase(const BoundPersistentOptimizations& opt);
 		
 		// DATA MEMBERS
 		
@@ -227,12 +267,12 @@ namespace exploration
 		 }
 		 @endcode
 		 */
-		template<typename Dependence>
-		Tids alternatives(
+		template<typename Dependence, typename clock_t>
+		tid_set alternatives(
 			const execution& E,
 			const unsigned int index,
 			const SufficientSet& s,
-			const HappensBefore<Dependence>& HB,
+			const HappensBefore<Dependence, clock_t>& HB,
 			const backtrack_point& point) const
 		{
 			return Persistent::alternatives(E, index, s, HB, point, mOpt.SLEEPSETS() != mOpt.sleep_t::NEVER);
@@ -240,9 +280,8 @@ namespace exploration
 		
 		bool adding_condition(const State& s, const SufficientSet& suf, const Thread::tid_t& tid) const;
 		
-		Tids adding_tids(const State& s, const SufficientSet& suf) const;
+		tid_set adding_tids(const State& s, const SufficientSet& suf) const;
 		
-		static const std::string name;
 		static const std::string tabs;
 		static std::string outputname();
 		
@@ -279,17 +318,28 @@ namespace exploration
         
         // CTOR
         
-		explicit BoundPersistent(const typename BoundFunction::value_t bound)
-        : BoundPersistentBase()
+		explicit BoundPersistent(
+			const typename BoundFunction::value_t bound,
+			const BoundPersistentOptimizations& opt=BoundPersistentOptimizations())
+        : BoundPersistentBase(opt)
 		, mBound(bound) { }
 		
 		//
+		
+		static std::string name()
+		{
+			std::string name = BoundPersistentBase::name();
+			name += "<";
+			name += BoundFunction::name();
+			name += ">";
+			return name;
+		}
         
         void update_state(const execution& E, const transition& t)
         {
             const auto tid = boost::apply_visitor(program_model::get_tid(), t.instr());
             mState.emplace_back(BoundFunction::value(E, mState, t.index()-1, tid));
-            DEBUGF(outputname(), "update_state", t.instr(), to_string_post_state(t) << ".boundvalue = " << mState.back().boundvalue() << "\n");
+            DEBUGF(outputname(), "update_state", t.instr(), to_string_post_state(t) << ".bound_value = " << mState.back().bound_value() << "\n");
         }
         
         /**
@@ -321,12 +371,12 @@ namespace exploration
          @note Current implementation does prioritize point.tid iff it
          is an alternative with *least* boundvalue.
          */
-		template<typename Dependence>
+		template<typename Dependence, typename clock_t>
         void add_backtrack_point(
             const execution& E,
             const unsigned int index,
             std::vector<SufficientSet>& S,
-            const HappensBefore<Dependence>& HB,
+            const HappensBefore<Dependence, clock_t>& HB,
             const backtrack_point& point,
             bool conservative=false)
         {
@@ -338,7 +388,7 @@ namespace exploration
                     alt = *(BoundFunction::min_value(E, point.index-1, Alt, {point.tid}));
                 }
             }
-            Tids Add{};
+            tid_set Add{};
             if (adding_condition(E[point.index].pre(), S[point.index-1], alt)) {
                 Add = { alt };
             } else {
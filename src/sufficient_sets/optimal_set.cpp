@@ -0,0 +1,105 @@
+
+#include "optimal_set.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace exploration
+{
+	Optimal::Optimal()
+	: mTrees({ wakeup_tree() })
+	, mOperands() { }
+
+	bool Optimal::check_valid(const bool contains_locks) const
+	{
+		if (contains_locks) { ERROR(name(), "Assumes threads do not disable each other"); }
+		return !contains_locks;
+	}
+
+    std::string Optimal::name()
+    {
+        return "Optimal";
+    }
+
+    void Optimal::update_state(const execution& E, const transition& t)
+    {
+        /// @pre mTrees.size() == t.index()
+        assert(mTrees.size() == t.index());
+        const transition_record record = make_record(t.instr(), mOperands);
+        mTrees.back().add_leaf(record);
+        mTrees.push_back(mTrees.back().subtree(record.tid));
+    }
+
+    void Optimal::update_after_exploration(const transition& t, SufficientSet&)
+    {
+        const auto tid = boost::apply_visitor(program_model::get_tid(), t.instr());
+        mTrees[t.index()-1].remove(tid);
+    }
+
+    void Optimal::add_to_pool(tid_set& pool, const std::size_t index) const
+    {
+        pool |= mTrees[index].children();
+    }
+
+    bool Optimal::condition(const execution&, SufficientSet&, const Thread::tid_t& tid) const
+    {
+        const bool leftmost = mTrees.back().empty() || mTrees.back().first() == tid;
+        DEBUGF(outputname(), "condition", tid, " = " << leftmost << "\n");
+        return leftmost;
+    }
+
+    std::vector<Thread::tid_t> Optimal::wakeup_sequence(
+        const State& s, const Thread::tid_t& tid, SleepSet& sleep)
+    {
+        if (!mTrees.back().contains(tid)) {
+            return {};
+        }
+        const wakeup_tree::sequence_t branch = mTrees.back().branch(tid);
+        tid_set woken{};
+        for (const auto& asleep : sleep.asleep()) {
+            if (s.has_next(asleep)) {
+                const transition_record next = make_record(s.next(asleep)->second.instr, mOperands);
+                if (std::any_of(branch.begin(), branch.end(), [&next] (const auto& transition) {
+                        return Dependence::dependent(transition, next); })) {
+                    woken.insert(asleep);
+                }
+            }
+        }
+        for (const auto& asleep : woken) {
+            sleep.wake_up(asleep);
+        }
+        std::vector<Thread::tid_t> sequence{};
+        std::transform(
+            std::next(branch.begin()), branch.end(), std::back_inserter(sequence),
+            [] (const auto& transition) { return transition.tid; });
+        return sequence;
+    }
+
+    void Optimal::pop_back()
+    {
+        mTrees.pop_back();
+    }
+
+    void Optimal::save(std::ostream&) const
+    {
+        throw std::runtime_error(name() + " does not support checkpoints");
+    }
+
+    void Optimal::restore(std::istream&)
+    {
+        throw std::runtime_error(name() + " does not support checkpoints");
+    }
+
+    std::string Optimal::tabs()
+    {
+        return "\t\t\t";
+    }
+
+    std::string Optimal::outputname()
+    {
+        std::string outputname = tabs();
+		outputname += text_color(name(), utils::io::Color::GREEN);
+        return outputname;
+    }
+} // end namespace exploration
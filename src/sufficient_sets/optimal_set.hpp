@@ -0,0 +1,184 @@
+
+#ifndef OPTIMAL_SET_HPP_INCLUDED
+#define OPTIMAL_SET_HPP_INCLUDED
+
+#include "sufficient_set.hpp"
+#include "source_set.hpp"
+#include "transition_io.hpp"
+#include "wakeup_tree.hpp"
+
+/*---------------------------------------------------------------------------75*/
+/**
+ @file optimal_set.hpp
+ @brief Definition of class Optimal.
+ @author Susanne van den Elsen
+ @date 2017
+ */
+/*---------------------------------------------------------------------------++*/
+
+using namespace program_model;
+
+namespace exploration
+{
+    /**
+     The Optimal implementation of SufficientSet is the optimal DPOR
+     algorithm from @cite abdulla-popl-14. It extends Source with a
+     wakeup_tree per state, such that each Mazurkiewicz trace is explored
+     exactly once and no exploration is sleep-set blocked.
+     @details The races are detected as in Source. Instead of adding a
+     single thread to the backtrack set, the sequence that reverses a race
+     is inserted into the wakeup_tree of the state before the race. The
+     pool of a state is the set of children of its wakeup_tree, which are
+     explored from left to right, each followed by the leftmost branch
+     below it (see wakeup_sequence).
+     */
+    class Optimal
+    {
+    public:
+
+        // TYPES
+
+        using execution = Execution;
+        using transition = typename Execution::transition_t;
+
+        // CTOR
+
+        Optimal();
+
+        //
+
+		/**
+		 @brief Returns !contains_locks.
+		 */
+		bool check_valid(const bool contains_locks) const;
+
+        static std::string name();
+
+        /**
+         @brief The wakeup sequences already keep executions from being
+         blocked by the sleepset.
+         */
+        static constexpr bool prune_sleepset_blocked = false;
+
+        /**
+         @brief See Source::skip_unchanged_threads.
+         */
+        static constexpr bool skip_unchanged_threads = false;
+
+        /**
+         @brief Adds t as a leaf to the wakeup_tree of t.pre (if t does not
+         follow one of its branches) and pushes the subtree of t as the
+         wakeup_tree of t.post.
+         */
+        void update_state(const execution& E, const transition& t);
+
+        /**
+         @brief Returns the races of E[index], as in Source.
+         */
+        template<typename Dependence, typename clock_t>
+        BacktrackPoints backtrack_points(
+            const execution& E,
+            const unsigned int index,
+            const HappensBefore<Dependence, clock_t>& HB) const
+        {
+            return Source::backtrack_points(E, index, HB);
+        }
+
+        /**
+         @cite abdulla-popl-14
+         @verbatim
+         Optimal::add_backtrack_point(E, index, point) {
+            E' := pre(E, point.index);
+            v := notdep(point.index, E).E[index];
+            if (sleep(E') cap WI[E'](v) = {}) {
+               insert[E'](v, wut(E'));
+            }
+         }
+         @endverbatim
+         @see HappensBefore::incomparable_after
+         */
+        template<typename Dependence, typename clock_t>
+        void add_backtrack_point(
+            const execution& E,
+            const unsigned int index,
+            std::vector<SufficientSet>& S,
+            const HappensBefore<Dependence, clock_t>& HB,
+            const backtrack_point& point)
+        {
+            DEBUGF(outputname(), "add_backtrack_point", point, "\n");
+            wakeup_tree::sequence_t v{};
+            for (const auto& j : HB.incomparable_after(point.index, index)) {
+                v.push_back(make_record(E[j].instr(), mOperands));
+            }
+            v.push_back(make_record(E[index].instr(), mOperands));
+            const State& s = E[point.index].pre();
+            for (const auto& asleep : S[point.index-1].sleepset().asleep()) {
+                if (s.has_next(asleep) &&
+                    weak_initial(make_record(s.next(asleep)->second.instr, mOperands), v)) {
+                    DEBUG(tabs() << asleep << " in sleep cap WI(v)\n");
+                    return;
+                }
+            }
+            if (mTrees[point.index-1].insert(std::move(v))) {
+                DEBUG(tabs() << to_string_pre(point.index) << ".wut.insert(v)\n");
+            }
+        }
+
+        /**
+         @brief Removes the subtree of t from the wakeup_tree of t.pre.
+         */
+        void update_after_exploration(const transition& t, SufficientSet&);
+
+        /**
+         @brief Adds the children of the wakeup_tree of the index'th state to
+         pool.
+         */
+        void add_to_pool(tid_set& pool, const std::size_t index) const;
+
+        /**
+         @brief Returns true iff tid is the leftmost child of the wakeup_tree
+         of the current state.
+         */
+        bool condition(const execution&, SufficientSet&, const Thread::tid_t& tid) const;
+
+        /**
+         @brief Returns the leftmost branch below the child tid of the
+         wakeup_tree of the current state s, and wakes up the threads in
+         sleep whose next Transition in s is dependent with the branch
+         (including tid's Transition).
+         */
+        std::vector<Thread::tid_t> wakeup_sequence(
+            const State& s, const Thread::tid_t& tid, SleepSet& sleep);
+
+        void pop_back();
+
+        /**
+         @brief Checkpoints are not supported, as the operand ids in mTrees
+         refer to mOperands, which is not rebuilt by replaying the current
+         branch.
+         @throws std::runtime_error
+         */
+        void save(std::ostream&) const;
+        void restore(std::istream&);
+
+    private:
+
+        // DATA MEMBERS
+
+        /// @brief mTrees[i] is the wakeup_tree of the i'th state of the
+        /// current execution.
+        std::vector<wakeup_tree> mTrees;
+
+        /// @brief Interns the operands of the Transitions in mTrees.
+        operand_interner mOperands;
+
+        // DEBUGGING
+
+        static std::string tabs();
+
+        static std::string outputname();
+
+    }; // end class Optimal
+} // end namespace exploration
+
+#endif
@@ -21,7 +21,16 @@ namespace exploration
     /**
      @brief Does nothing.
      */
-    void Persistent::add_to_pool(Tids&) { }
+    void Persistent::add_to_pool(tid_set&, const std::size_t) { }
+    
+    /**
+     @brief Returns an empty sequence.
+     */
+    std::vector<Thread::tid_t> Persistent::wakeup_sequence(
+        const State&, const Thread::tid_t&, SleepSet&)
+    {
+        return {};
+    }
     
     /**
      @brief Always returns true.
@@ -43,6 +43,20 @@ namespace exploration
 		}
         
         static std::string name();
+        
+        /**
+         @brief Lets dpor skip schedules that it predicts to be blocked by
+         the sleepset, as update_after_exploration does not depend on the
+         Transitions of the skipped execution.
+         */
+        static constexpr bool prune_sleepset_blocked = true;
+        
+        /**
+         @brief Lets dpor pass the threads of which the backtrack points
+         did not change since the previous index to backtrack_points.
+         @see dpor_base::unchanged_threads
+         */
+        static constexpr bool skip_unchanged_threads = true;
                 
         static void update_state(const execution& E, const transition& t);
         
@@ -60,19 +74,26 @@ namespace exploration
 		 return Points;
 		 }
 		 @endcode
+         @details The points of the threads in unchanged were already added at index-1 and are 
+         not recomputed.
          @see HappensBefore::max_dependent
+         @see dpor_base::unchanged_threads
          */
-        template<typename Dependence>
+        template<typename Dependence, typename clock_t>
         static BacktrackPoints backtrack_points(
             const execution& E,
             const unsigned int index,
-            const HappensBefore<Dependence>& HB)
+            const HappensBefore<Dependence, clock_t>& HB,
+            const tid_set& unchanged = {})
         {
             DEBUGF(outputname(), "backtrack_points", to_short_string(E[index]), "\n");
             BacktrackPoints Points{};
             std::for_each(
                 E[index].pre().next_cbegin(), E[index].pre().next_cend(),
-                [&index, &HB, &Points] (const auto& next) {
+                [&index, &HB, &Points, &unchanged] (const auto& next) {
+                    if (unchanged.count(next.first) > 0) {
+                        return;
+                    }
                     auto maxdep = HB.max_dependent(index, next.second.instr, true, true);
                     if (maxdep > 0) {
                         Points.push_back({ next.first, maxdep });
@@ -88,12 +109,12 @@ namespace exploration
          @details The implementation prioritizes point.tid if it is an
          alternative to avoid an unnecessary call to Persistent::alternatives.
          */
-        template<typename Dependence>
+        template<typename Dependence, typename clock_t>
         static void add_backtrack_point(
             const execution& E,
             const unsigned int index,
             std::vector<SufficientSet>& S,
-            const HappensBefore<Dependence>& HB,
+            const HappensBefore<Dependence, clock_t>& HB,
             const backtrack_point& point)
         {
             DEBUGF(outputname(), "add_backtrack_point", point, "\n");
@@ -104,46 +125,50 @@ namespace exploration
                 DEBUG(tabs() << to_string_pre(point.index) << ".backtrack.add(" << point.tid << ")");
                 s_.add_to_backtrack(point.tid);
             } else {
-                Tids Alt = alternatives(E, index, s_, HB, point);
+                tid_set Alt = alternatives(E, index, s_, HB, point);
                 if (!Alt.empty()) {
                     DEBUG(tabs() << to_string_pre(point.index) << ".backtrack.add(" << *(Alt.begin()) << ")");
                     s_.add_to_backtrack(*(Alt.begin()));
                 } else {
                     DEBUG(tabs() << to_string_pre(point.index) << ".backtrack.add(enabled)");
-                    s_.add_to_backtrack(s.enabled());
+                    s_.add_to_backtrack(tid_set(s.enabled()));
                 }
             }
         }
         
         static void update_after_exploration(const transition&, SufficientSet&);
         
-        static void add_to_pool(Tids&);
+        static void add_to_pool(tid_set&, const std::size_t);
+        
+        static std::vector<Thread::tid_t> wakeup_sequence(
+            const State&, const Thread::tid_t&, SleepSet&);
         
         static bool condition(const execution&, SufficientSet&, const Thread::tid_t&);
         
         static void pop_back();
         
+        /**
+         @brief Do nothing, as Persistent keeps no state of its own.
+         */
+        static void save(std::ostream&) { }
+        static void restore(std::istream&) { }
+        
 		/**
          @cite flanagan-popl-05 and addendum.
          */
-        template<typename Dependence>
-        static Tids alternatives(
+        template<typename Dependence, typename clock_t>
+        static tid_set alternatives(
             const execution& E,
             const unsigned int index,
             const SufficientSet& s,
-            const HappensBefore<Dependence>& HB,
+            const HappensBefore<Dependence, clock_t>& HB,
             const backtrack_point& point,
 			bool use_sleepsets=true)
         {
-            Tids Alt = HB.thread_transitive_relation(index, point.index, point.tid);
+            tid_set Alt = HB.thread_transitive_relation(index, point.index, point.tid);
             Alt.insert(point.tid);
             const auto& enabled = E[point.index].pre().enabled();
-            Tids AltEnabled{};
-            std::set_intersection(
-                Alt.begin(), Alt.end(),
-                enabled.begin(), enabled.end(),
-                std::inserter(AltEnabled, AltEnabled.end())
-            );
+            const tid_set AltEnabled = Alt & tid_set(enabled);
 			DEBUGF(outputname(), "alternatives", point, " = (" << Alt << " U {" << point.tid << "}) cap" << enabled);
 			if (use_sleepsets) {
 				DEBUG(" \\ " << s.sleepset() << " = " << s.sleepset().awake(AltEnabled) << "\n");
@@ -38,20 +38,24 @@ namespace exploration
         mSleep.erase(tid);
     }
     
-    const Tids SleepSet::awake(const Tids& tids) const
+    tid_set SleepSet::awake(const tid_set& tids) const
     {
-        Tids awake{};
-        std::set_difference(
-            tids.begin(), tids.end(),
-            mSleep.begin(), mSleep.end(),
-            std::inserter(awake, awake.begin())
-        );
-        return awake;
+        return tids - mSleep;
+    }
+    
+    Tids SleepSet::awake(const Tids& tids) const
+    {
+        return awake(tid_set(tids)).to_tids();
     }
     
     bool SleepSet::is_awake(const Thread::tid_t& tid) const
     {
-        return mSleep.find(tid) == mSleep.end();
+        return mSleep.count(tid) == 0;
+    }
+    
+    const tid_set& SleepSet::asleep() const
+    {
+        return mSleep;
     }
     
     std::ostream& operator<<(std::ostream& os, const SleepSet& sleep)
@@ -62,7 +66,9 @@ namespace exploration
     
     std::istream& operator>>(std::istream& is, SleepSet& sleep)
     {
-        is >> sleep.mSleep;
+        Tids sleep_tids{};
+        is >> sleep_tids;
+        sleep.mSleep = tid_set(sleep_tids);
         return is;
     }
     
@@ -6,6 +6,7 @@
 #include "debug.hpp"
 #include "dependence.hpp"
 #include "state.hpp"
+#include "tid_set.hpp"
 #include "visible_instruction.hpp"
 
 /*---------------------------------------------------------------------------75*/
@@ -67,13 +68,14 @@ namespace exploration
             const Retrieve retrieve,
             const Dependence& D)
         {
-            // Cannot use std::remove_if on std::set.
-            for (auto asleep = mSleep.begin(); asleep != mSleep.end(); ) {
+            tid_set woken{};
+            for (auto asleep = mSleep.begin(); asleep != mSleep.end(); ++asleep) {
                 if (pool.has_next(*asleep) && D.dependent(instr, retrieve(pool, asleep))) {
                     DEBUG(*asleep << " ");
-                    asleep = mSleep.erase(asleep);
-                } else { ++asleep; }
+                    woken.insert(*asleep);
+                }
             };
+            mSleep -= woken;
         }
         
         /**
@@ -89,19 +91,30 @@ namespace exploration
         /**
          @brief Returns { tid in Tids | tid notin mSleep }.
          */
-        const Tids awake(const Tids&) const;
+        tid_set awake(const tid_set&) const;
+        
+        /**
+         @brief Overload for the program_model::Tids handed to the
+         scheduler's selection strategy.
+         */
+        Tids awake(const Tids&) const;
         
         /**
          @brief Returns true iff tid notin mSleep.
          */
         bool is_awake(const Thread::tid_t&) const;
         
+        /**
+         @brief Returns mSleep.
+         */
+        const tid_set& asleep() const;
+        
     private:
         
         // DATA MEMBERS
 		
         /// @brief The actual sleepset.
-        Tids mSleep;
+        tid_set mSleep;
 
     //friendly:
         
@@ -28,7 +28,16 @@ namespace exploration
     /**
      @brief Does nothing.
      */
-    void Source::add_to_pool(Tids&) { }
+    void Source::add_to_pool(tid_set&, const std::size_t) { }
+    
+    /**
+     @brief Returns an empty sequence.
+     */
+    std::vector<Thread::tid_t> Source::wakeup_sequence(
+        const State&, const Thread::tid_t&, SleepSet&)
+    {
+        return {};
+    }
     
     /**
      @brief Always returns true.
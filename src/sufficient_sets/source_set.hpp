@@ -43,6 +43,17 @@ namespace exploration
 		bool check_valid(const bool contains_locks) const;
         
         static std::string name();
+        
+        /**
+         @brief See Persistent::prune_sleepset_blocked.
+         */
+        static constexpr bool prune_sleepset_blocked = true;
+        
+        /**
+         @brief Only E[index] is analysed, hence there are no unchanged
+         threads to skip.
+         */
+        static constexpr bool skip_unchanged_threads = false;
                 
         static void update_state(const execution& E, const transition& t);
         
@@ -54,11 +65,11 @@ namespace exploration
          }
          @endverbatim
          */
-        template<typename Dependence>
+        template<typename Dependence, typename clock_t>
         static BacktrackPoints backtrack_points(
             const execution& E,
             const unsigned int index,
-            const HappensBefore<Dependence>& HB)
+            const HappensBefore<Dependence, clock_t>& HB)
         {
             DEBUGF(outputname(), "backtrack_points", to_short_string(E[index]), "\n");
             VectorClock::indices_t Covering = HB.covering(index, E[index].instr());
@@ -78,33 +89,28 @@ namespace exploration
          @see HappensBefore::incomparable_after
          @see HappensBefore::front
          */
-        template<typename Dependence>
+        template<typename Dependence, typename clock_t>
         static void add_backtrack_point(
             const execution& E,
             const unsigned int index,
             std::vector<SufficientSet>& S,
-            const HappensBefore<Dependence>& HB,
+            const HappensBefore<Dependence, clock_t>& HB,
             const backtrack_point& point)
         {
             DEBUGF(outputname(), "add_backtrack_point", point, "\n");
             VectorClock::values_t v = HB.incomparable_after(point.index, index);
             v.insert(index);
-            Tids Front = HB.tids(HB.front(v));
+            const tid_set Front = HB.tids(HB.front(v));
             /// @invariant !Front.empty()
             assert(!Front.empty());
-            Tids SourcesFor{};
-            std::set_intersection(
-                S[point.index-1].backtrack().cbegin(), S[point.index-1].backtrack().cend(),
-                Front.cbegin(), Front.cend(),
-                std::inserter(SourcesFor, SourcesFor.begin())
-            );
+            const tid_set SourcesFor = S[point.index-1].backtrack() & Front;
             DEBUG(
                 tabs() << to_string_pre(point.index) << ".backtrack cap Front = "
                   << S[point.index-1].backtrack() << " cap "
                   << Front  << " = " << SourcesFor
             );
             if (SourcesFor.empty()) {
-                Thread::tid_t add = (Front.find(point.tid) != Front.end())
+                Thread::tid_t add = (Front.count(point.tid) > 0)
                 ? point.tid : *(Front.begin());
                 DEBUG(tabs() << to_string_pre(point.index) << ".backtrack.add(" << add << ")");
                 S[point.index-1].add_to_backtrack(add);
@@ -113,12 +119,21 @@ namespace exploration
         
         static void update_after_exploration(const transition& t, SufficientSet&);
         
-        static void add_to_pool(Tids&);
+        static void add_to_pool(tid_set&, const std::size_t);
+        
+        static std::vector<Thread::tid_t> wakeup_sequence(
+            const State&, const Thread::tid_t&, SleepSet&);
         
         static bool condition(const execution&, SufficientSet&, const Thread::tid_t&);
         
         static void pop_back();
         
+        /**
+         @brief Do nothing, as Source keeps no state of its own.
+         */
+        static void save(std::ostream&) { }
+        static void restore(std::istream&) { }
+        
     private:
         
         // DEBUGGING
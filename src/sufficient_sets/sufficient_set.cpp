@@ -8,7 +8,7 @@ namespace exploration
     : mBacktrack()
     , mSleepSet() { }
     
-    const Tids& SufficientSet::backtrack() const
+    const tid_set& SufficientSet::backtrack() const
     {
         return mBacktrack;
     }
@@ -18,13 +18,9 @@ namespace exploration
         mBacktrack.insert(tid);
     }
     
-    void SufficientSet::add_to_backtrack(const Tids& tids)
+    void SufficientSet::add_to_backtrack(const tid_set& tids)
     {
-        std::set_union(
-            mBacktrack.begin(), mBacktrack.end(),
-            tids.begin(), tids.end(),
-            std::inserter(mBacktrack, mBacktrack.begin())
-        );
+        mBacktrack |= tids;
     }
     
     SleepSet& SufficientSet::sleepset()
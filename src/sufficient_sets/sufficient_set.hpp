@@ -38,15 +38,15 @@ namespace exploration
         
         SufficientSet();
         
-        SufficientSet(const Tids& backtrack, const SleepSet& sleepset)
+        SufficientSet(const tid_set& backtrack, const SleepSet& sleepset)
         : mBacktrack(backtrack)
         , mSleepSet(sleepset) { }
         
         //
         
-        const Tids& backtrack() const;
+        const tid_set& backtrack() const;
         void add_to_backtrack(const Thread::tid_t&);
-        void add_to_backtrack(const Tids&);
+        void add_to_backtrack(const tid_set&);
         
         SleepSet& sleepset();
         const SleepSet& sleepset() const;
@@ -57,7 +57,7 @@ namespace exploration
         
         // DATA MEMBERS
         
-        Tids mBacktrack;
+        tid_set mBacktrack;
         SleepSet mSleepSet;
         
     }; // end class SufficientSet
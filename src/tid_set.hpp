@@ -0,0 +1,291 @@
+#pragma once
+
+#include "container_output.hpp"
+#include "thread.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file tid_set.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief A set of Thread ids stored as a bitset, used instead of program_model::Tids for the
+/// sets that are built and combined in every state of an exploration.
+/// @details The ids [0,64) are stored inline, larger ids spill into a vector of words. Sets over
+/// programs with at most 64 threads therefore never allocate. Like program_model::Tids, a tid_set
+/// is iterated in increasing order.
+
+class tid_set
+{
+public:
+   using tid_t = program_model::Thread::tid_t;
+   using value_type = tid_t;
+   using word_t = std::uint64_t;
+
+   static constexpr std::size_t word_size = 64;
+
+   class const_iterator
+   {
+   public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = tid_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const tid_t*;
+      using reference = tid_t;
+
+      const_iterator()
+      : mSet(nullptr)
+      , mWord(0)
+      , mBits(0)
+      {
+      }
+
+      tid_t operator*() const
+      {
+         return static_cast<tid_t>(mWord * word_size + __builtin_ctzll(mBits));
+      }
+
+      const_iterator& operator++()
+      {
+         mBits &= mBits - 1;
+         skip_empty_words();
+         return *this;
+      }
+
+      const_iterator operator++(int)
+      {
+         const_iterator it = *this;
+         ++(*this);
+         return it;
+      }
+
+      bool operator==(const const_iterator& other) const
+      {
+         return mWord == other.mWord && mBits == other.mBits;
+      }
+
+      bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+   private:
+      const_iterator(const tid_set& set, const std::size_t word)
+      : mSet(&set)
+      , mWord(word)
+      , mBits(word < set.nr_words() ? set.word(word) : 0)
+      {
+         skip_empty_words();
+      }
+
+      void skip_empty_words()
+      {
+         while (mBits == 0 && mWord + 1 < mSet->nr_words())
+         {
+            mBits = mSet->word(++mWord);
+         }
+         if (mBits == 0)
+         {
+            mWord = mSet->nr_words();
+         }
+      }
+
+      const tid_set* mSet;
+      std::size_t mWord;
+      word_t mBits;
+
+      friend class tid_set;
+
+   }; // end class const_iterator
+
+   using iterator = const_iterator;
+
+   tid_set()
+   : mInline(0)
+   , mSpill()
+   {
+   }
+
+   tid_set(std::initializer_list<tid_t> tids)
+   : tid_set(tids.begin(), tids.end())
+   {
+   }
+
+   template <typename iterator_t>
+   tid_set(iterator_t first, const iterator_t last)
+   : tid_set()
+   {
+      for (; first != last; ++first)
+      {
+         insert(*first);
+      }
+   }
+
+   explicit tid_set(const program_model::Tids& tids)
+   : tid_set(tids.begin(), tids.end())
+   {
+   }
+
+   const_iterator begin() const { return const_iterator(*this, 0); }
+   const_iterator end() const { return const_iterator(*this, nr_words()); }
+   const_iterator cbegin() const { return begin(); }
+   const_iterator cend() const { return end(); }
+
+   bool empty() const
+   {
+      for (std::size_t w = 0; w < nr_words(); ++w)
+      {
+         if (word(w) != 0)
+            return false;
+      }
+      return true;
+   }
+
+   std::size_t size() const
+   {
+      std::size_t size = 0;
+      for (std::size_t w = 0; w < nr_words(); ++w)
+      {
+         size += __builtin_popcountll(word(w));
+      }
+      return size;
+   }
+
+   std::size_t count(const tid_t tid) const
+   {
+      /// @pre tid >= 0
+      assert(tid >= 0);
+      return (word(tid / word_size) >> (tid % word_size)) & 1;
+   }
+
+   void insert(const tid_t tid)
+   {
+      /// @pre tid >= 0
+      assert(tid >= 0);
+      word_ref(tid / word_size) |= word_t(1) << (tid % word_size);
+   }
+
+   std::size_t erase(const tid_t tid)
+   {
+      const std::size_t erased = count(tid);
+      if (erased > 0)
+      {
+         word_ref(tid / word_size) &= ~(word_t(1) << (tid % word_size));
+      }
+      return erased;
+   }
+
+   void clear()
+   {
+      mInline = 0;
+      mSpill.clear();
+   }
+
+   /// @brief Union.
+
+   tid_set& operator|=(const tid_set& other)
+   {
+      for (std::size_t w = 0; w < other.nr_words(); ++w)
+      {
+         if (other.word(w) != 0)
+            word_ref(w) |= other.word(w);
+      }
+      return *this;
+   }
+
+   /// @brief Intersection.
+
+   tid_set& operator&=(const tid_set& other)
+   {
+      for (std::size_t w = 0; w < nr_words(); ++w)
+      {
+         word_ref(w) &= other.word(w);
+      }
+      return *this;
+   }
+
+   /// @brief Difference.
+
+   tid_set& operator-=(const tid_set& other)
+   {
+      for (std::size_t w = 0; w < nr_words(); ++w)
+      {
+         word_ref(w) &= ~other.word(w);
+      }
+      return *this;
+   }
+
+   bool operator==(const tid_set& other) const
+   {
+      for (std::size_t w = 0; w < std::max(nr_words(), other.nr_words()); ++w)
+      {
+         if (word(w) != other.word(w))
+            return false;
+      }
+      return true;
+   }
+
+   bool operator!=(const tid_set& other) const { return !(*this == other); }
+
+   program_model::Tids to_tids() const { return program_model::Tids(begin(), end()); }
+
+private:
+   std::size_t nr_words() const { return 1 + mSpill.size(); }
+
+   word_t word(const std::size_t w) const
+   {
+      return w == 0 ? mInline : (w <= mSpill.size() ? mSpill[w - 1] : 0);
+   }
+
+   word_t& word_ref(const std::size_t w)
+   {
+      if (w == 0)
+         return mInline;
+      if (mSpill.size() < w)
+         mSpill.resize(w, 0);
+      return mSpill[w - 1];
+   }
+
+   word_t mInline;
+   std::vector<word_t> mSpill;
+
+}; // end class tid_set
+
+//--------------------------------------------------------------------------------------------------
+
+inline tid_set operator|(tid_set lhs, const tid_set& rhs)
+{
+   return lhs |= rhs;
+}
+
+inline tid_set operator&(tid_set lhs, const tid_set& rhs)
+{
+   return lhs &= rhs;
+}
+
+inline tid_set operator-(tid_set lhs, const tid_set& rhs)
+{
+   return lhs -= rhs;
+}
+
+/// @brief Writes tids in the format of program_model::Tids.
+
+inline std::ostream& operator<<(std::ostream& os, const tid_set& tids)
+{
+   return os << tids.to_tids();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
@@ -0,0 +1,96 @@
+
+#include "transition_record.hpp"
+
+#include <ostream>
+
+
+namespace exploration {
+namespace {
+
+//--------------------------------------------------------------------------------------------------
+
+operation_kind decode(const program_model::memory_operation operation)
+{
+   switch (operation)
+   {
+      case program_model::memory_operation::Load:
+         return operation_kind::load;
+      case program_model::memory_operation::Store:
+         return operation_kind::store;
+      case program_model::memory_operation::ReadModifyWrite:
+         return operation_kind::read_modify_write;
+      default:
+         return operation_kind::other;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+operation_kind decode(const program_model::lock_operation operation)
+{
+   switch (operation)
+   {
+      case program_model::lock_operation::Lock:
+         return operation_kind::lock;
+      case program_model::lock_operation::Unlock:
+         return operation_kind::unlock;
+      default:
+         return operation_kind::other;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+struct get_operation_kind : public boost::static_visitor<operation_kind>
+{
+   template <typename instruction_t>
+   operation_kind operator()(const instruction_t& instruction) const
+   {
+      return decode(instruction.operation());
+   }
+};
+
+} // end namespace
+
+//--------------------------------------------------------------------------------------------------
+
+transition_record make_record(const program_model::visible_instruction_t& instruction,
+                              operand_interner& operands)
+{
+   return {boost::apply_visitor(program_model::get_tid(), instruction),
+           boost::apply_visitor(get_operation_kind(), instruction),
+           operands.intern(boost::apply_visitor(program_model::get_operand(), instruction))};
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::ostream& operator<<(std::ostream& os, const operation_kind& operation)
+{
+   switch (operation)
+   {
+      case operation_kind::load:
+         return os << "load";
+      case operation_kind::store:
+         return os << "store";
+      case operation_kind::read_modify_write:
+         return os << "rmw";
+      case operation_kind::lock:
+         return os << "lock";
+      case operation_kind::unlock:
+         return os << "unlock";
+      default:
+         return os << "other";
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::ostream& operator<<(std::ostream& os, const transition_record& record)
+{
+   os << "<" << record.tid << ", " << record.operation << ", #" << record.operand << ">";
+   return os;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
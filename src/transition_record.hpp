@@ -0,0 +1,57 @@
+#pragma once
+
+#include "operand_interner.hpp"
+
+#include "thread.hpp"
+#include "visible_instruction.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+
+//--------------------------------------------------------------------------------------------------
+/// @file transition_record.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief The operation of a visible instruction. Operations that are neither a modification nor
+/// a lock or unlock are decoded as other and treated like a load by Dependence.
+
+enum class operation_kind : std::uint8_t
+{
+   load,
+   store,
+   read_modify_write,
+   lock,
+   unlock,
+   other
+};
+
+/// @brief A visible instruction decoded once into the fields that the happens-before analysis
+/// reads, such that queries compare integers instead of visiting the instruction variant.
+
+struct transition_record
+{
+   program_model::Thread::tid_t tid;
+   operation_kind operation;
+   operand_interner::id_t operand;
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Decodes instruction, interning its operand in operands.
+
+transition_record make_record(const program_model::visible_instruction_t& instruction,
+                              operand_interner& operands);
+
+std::ostream& operator<<(std::ostream&, const operation_kind&);
+std::ostream& operator<<(std::ostream&, const transition_record&);
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
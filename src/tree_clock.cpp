@@ -0,0 +1,173 @@
+
+#include "tree_clock.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+constexpr tree_clock::tid_t tree_clock::none;
+
+//--------------------------------------------------------------------------------------------------
+
+tree_clock::tree_clock(const clock_view& values, const tid_t root)
+: mRoot(root)
+, mClk(values.cbegin(), values.cend())
+, mAclk(values.size(), 0)
+, mParent(values.size(), none)
+, mFirstChild(values.size(), none)
+, mNextSibling(values.size(), none)
+, mPreviousSibling(values.size(), none)
+, mUpdated()
+{
+   /// @pre root < values.size()
+   assert(static_cast<std::size_t>(root) < values.size());
+   assign(values);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::assign(const clock_view& values)
+{
+   /// @pre values.size() == size()
+   assert(values.size() == size());
+   std::copy(values.cbegin(), values.cend(), mClk.begin());
+   std::fill(mParent.begin(), mParent.end(), none);
+   std::fill(mFirstChild.begin(), mFirstChild.end(), none);
+   std::fill(mNextSibling.begin(), mNextSibling.end(), none);
+   std::fill(mPreviousSibling.begin(), mPreviousSibling.end(), none);
+   for (tid_t tid = 0; tid < static_cast<tid_t>(size()); ++tid)
+   {
+      if (tid != mRoot && mClk[tid] > 0)
+      {
+         push_front_child(mRoot, tid, mClk[mRoot]);
+      }
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+tree_clock::operator clock_view() const
+{
+   return clock_view(mClk.data(), mClk.size());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::advance(const value_t value)
+{
+   /// @pre value >= mClk[mRoot]
+   assert(value >= mClk[mRoot]);
+   mClk[mRoot] = value;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::join(const tree_clock& other)
+{
+   /// @pre size() == other.size()
+   assert(size() == other.size());
+   const tid_t z = other.mRoot;
+   if (other.mClk[z] <= mClk[z])
+      return;
+   assert(z != mRoot);
+
+   mUpdated.clear();
+   collect_updated(other, z);
+   for (const auto& u : mUpdated)
+   {
+      detach(u);
+      mClk[u] = other.mClk[u];
+   }
+   // Parents before children and, among siblings, increasing aclk, such that pushing to the
+   // front keeps the children of every node ordered by decreasing aclk.
+   for (auto it = mUpdated.rbegin(); it != mUpdated.rend(); ++it)
+   {
+      if (*it == z)
+         push_front_child(mRoot, z, mClk[mRoot]);
+      else
+         push_front_child(other.mParent[*it], *it, other.mAclk[*it]);
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::join(const clock_view& values)
+{
+   /// @pre size() == values.size()
+   assert(size() == values.size());
+   for (tid_t tid = 0; tid < static_cast<tid_t>(size()); ++tid)
+   {
+      join(tid, values[tid]);
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::join(const tid_t tid, const value_t value)
+{
+   if (value > mClk[tid])
+   {
+      assert(tid != mRoot);
+      detach(tid);
+      mClk[tid] = value;
+      push_front_child(mRoot, tid, mClk[mRoot]);
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::collect_updated(const tree_clock& other, const tid_t u)
+{
+   for (tid_t v = other.mFirstChild[u]; v != none; v = other.mNextSibling[v])
+   {
+      if (mClk[v] < other.mClk[v])
+      {
+         collect_updated(other, v);
+      }
+      else if (other.mAclk[v] <= mClk[u])
+      {
+         // This tree_clock knew u at a time u knew v and all of v's later siblings
+         break;
+      }
+   }
+   mUpdated.push_back(u);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::detach(const tid_t u)
+{
+   const tid_t parent = mParent[u];
+   if (parent == none)
+      return;
+   if (mPreviousSibling[u] != none)
+      mNextSibling[mPreviousSibling[u]] = mNextSibling[u];
+   else
+      mFirstChild[parent] = mNextSibling[u];
+   if (mNextSibling[u] != none)
+      mPreviousSibling[mNextSibling[u]] = mPreviousSibling[u];
+   mParent[u] = none;
+   mNextSibling[u] = none;
+   mPreviousSibling[u] = none;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void tree_clock::push_front_child(const tid_t parent, const tid_t u, const value_t aclk)
+{
+   mParent[u] = parent;
+   mAclk[u] = aclk;
+   mPreviousSibling[u] = none;
+   mNextSibling[u] = mFirstChild[parent];
+   if (mFirstChild[parent] != none)
+      mPreviousSibling[mFirstChild[parent]] = u;
+   mFirstChild[parent] = u;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
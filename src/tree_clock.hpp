@@ -0,0 +1,100 @@
+#pragma once
+
+#include "vector_clock.hpp"
+
+#include "thread.hpp"
+
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file tree_clock.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief A clock of a Thread (the root) that stores the same values as a VectorClock, but
+/// organizes them in a tree recording through which Thread each value was learned, as described
+/// in @cite mathur-asplos-22.
+/// @details A node u is a child of v if v's clock was the most recent to tell the root about u's
+/// value, and aclk(u) is the value of v at the time it learned about u. The children of a node
+/// are ordered by decreasing aclk. Thread ids with value 0 are not part of the tree.
+/// When joining a tree_clock of another root, this allows to skip every subtree of which this
+/// tree_clock already knows the values, so that a join only touches the entries that advance.
+
+class tree_clock
+{
+public:
+   using tid_t = program_model::Thread::tid_t;
+   using value_t = clock_view::value_t;
+
+   /// @brief Constructs a tree_clock of root with the given values, in which every other Thread
+   /// with a non-zero value is a child of the root, learned at values[root].
+   /// @note This is sound as a happens-before clock knows what the root knew at its last
+   /// Transition.
+
+   tree_clock(const clock_view& values, const tid_t root);
+
+   /// @brief Rebuilds this tree_clock from values as the constructor does, without reallocating.
+   /// @pre values.size() == size()
+
+   void assign(const clock_view& values);
+
+   std::size_t size() const { return mClk.size(); }
+   value_t operator[](const tid_t tid) const { return mClk[tid]; }
+
+   /// @brief Returns a view of the values of this tree_clock, indexed by Thread.
+
+   operator clock_view() const;
+
+   /// @brief Sets the value of the root to value.
+   /// @pre value >= (*this)[root]
+
+   void advance(const value_t value);
+
+   /// @brief Transforms this tree_clock into the pointwise max of itself and other, visiting only
+   /// the nodes of other whose values are greater than the values in this tree_clock.
+   /// @pre The root of this tree_clock has already been advanced beyond other, i.e. the join
+   /// happens at the time (*this)[root].
+
+   void join(const tree_clock& other);
+
+   /// @brief Transforms this tree_clock into the pointwise max of itself and the values of a
+   /// VectorClock. Every entry that advances is attached to the root.
+   /// @complexity O(n) with n = size().
+
+   void join(const clock_view& values);
+
+   /// @brief Raises the value of tid to value, if it is greater, attaching it to the root.
+
+   void join(const tid_t tid, const value_t value);
+
+private:
+   static constexpr tid_t none = -1;
+
+   tid_t mRoot;
+   std::vector<value_t> mClk;
+   std::vector<value_t> mAclk;
+   std::vector<tid_t> mParent;
+   std::vector<tid_t> mFirstChild;
+   std::vector<tid_t> mNextSibling;
+   std::vector<tid_t> mPreviousSibling;
+
+   /// @brief Nodes updated by the current join, children before their parents.
+   std::vector<tid_t> mUpdated;
+
+   /// @brief Adds u to mUpdated, preceded by the nodes in u's subtree in other that are updated.
+   void collect_updated(const tree_clock& other, const tid_t u);
+
+   void detach(const tid_t u);
+   void push_front_child(const tid_t parent, const tid_t u, const value_t aclk);
+
+}; // end class tree_clock
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
@@ -1,15 +1,31 @@
 
 #include "vector_clock.hpp"
+#include "vector_clock_kernels.hpp"
 
 #include <algo.hpp>
 
+#include <algorithm>
 #include <assert.h>
+#include <ostream>
 
 
 namespace exploration {
 
 //--------------------------------------------------------------------------------------------------
 
+std::ostream& operator<<(std::ostream& os, const clock_view& clock)
+{
+   os << "<";
+   for (std::size_t i = 0; i < clock.size(); ++i)
+   {
+      os << (i > 0 ? ", " : "") << clock[i];
+   }
+   os << ">";
+   return os;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 VectorClock::VectorClock(std::size_t n)
 : datastructures::fixed_size_vector<int>(n, 0)
 {
@@ -17,7 +33,7 @@ VectorClock::VectorClock(std::size_t n)
 
 //--------------------------------------------------------------------------------------------------
 
-VectorClock::VectorClock(const VectorClock& other, const std::size_t n)
+VectorClock::VectorClock(const clock_view& other, const std::size_t n)
 : datastructures::fixed_size_vector<int>(n, 0)
 {
     std::copy_n(other.cbegin(), std::min(other.size(), n), this->begin());
@@ -25,48 +41,90 @@ VectorClock::VectorClock(const VectorClock& other, const std::size_t n)
 
 //--------------------------------------------------------------------------------------------------
 
-void VectorClock::max(const VectorClock& other)
+VectorClock::operator clock_view() const
+{
+   return clock_view(size() > 0 ? &(*this)[0] : nullptr, size());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void VectorClock::assign(const clock_view& other)
 {
    /// @pre mSize == other.size()
    assert(size() == other.size());
-   for (index_t i = 0; i < size(); ++i)
+   std::copy(other.cbegin(), other.cend(), this->begin());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void VectorClock::max(const clock_view& other)
+{
+   /// @pre mSize == other.size()
+   assert(size() == other.size());
+   if (size() < kernels::min_size)
+   {
+      for (std::size_t i = 0; i < size(); ++i)
+      {
+         (*this)[i] = std::max((*this)[i], other[i]);
+      }
+   }
+   else
    {
-      (*this)[i] = std::max((*this)[i], other[i]);
+      kernels::get().max(&(*this)[0], other.cbegin(), size());
    }
 }
 
 //--------------------------------------------------------------------------------------------------
 
-void VectorClock::filter_values_greater_than(const VectorClock& other)
+void VectorClock::filter_values_greater_than(const clock_view& other)
 {
    /// @pre mSize == other.size()
    assert(size() == other.size());
-   for (index_t i = 0; i < size(); ++i)
+   if (size() < kernels::min_size)
    {
-      if ((*this)[i] <= other[i])
+      for (std::size_t i = 0; i < size(); ++i)
       {
-         (*this)[i] = 0;
+         if ((*this)[i] <= other[i])
+         {
+            (*this)[i] = 0;
+         }
       }
    }
+   else
+   {
+      kernels::get().filter_values_greater_than(&(*this)[0], other.cbegin(), size());
+   }
 }
 
 //--------------------------------------------------------------------------------------------------
 
-VectorClock::value_t min_element(const VectorClock& clock)
+VectorClock::value_t min_element(const clock_view& clock)
 {
-   return *std::min_element(clock.cbegin(), clock.cend());
+   /// @pre clock.size() > 0
+   assert(clock.size() > 0);
+   if (clock.size() < kernels::min_size)
+   {
+      return *std::min_element(clock.cbegin(), clock.cend());
+   }
+   return kernels::get().min_element(clock.cbegin(), clock.size());
 }
 
 //--------------------------------------------------------------------------------------------------
 
-VectorClock::value_t max_element(const VectorClock& clock)
+VectorClock::value_t max_element(const clock_view& clock)
 {
-   return *std::max_element(clock.cbegin(), clock.cend());
+   /// @pre clock.size() > 0
+   assert(clock.size() > 0);
+   if (clock.size() < kernels::min_size)
+   {
+      return *std::max_element(clock.cbegin(), clock.cend());
+   }
+   return kernels::get().max_element(clock.cbegin(), clock.size());
 }
 
 //--------------------------------------------------------------------------------------------------
 
-VectorClock::indices_t indices_such_that(const VectorClock& clock, const value_predicate_t& pred)
+VectorClock::indices_t indices_such_that(const clock_view& clock, const value_predicate_t& pred)
 {
    VectorClock::indices_t indices;
    utils::algo::copy_index_if(clock.cbegin(), clock.cend(), std::inserter(indices, indices.end()),
@@ -76,7 +134,7 @@ VectorClock::indices_t indices_such_that(const VectorClock& clock, const value_p
 
 //--------------------------------------------------------------------------------------------------
 
-VectorClock::values_t values_such_that(const VectorClock& clock, const value_predicate_t& pred)
+VectorClock::values_t values_such_that(const clock_view& clock, const value_predicate_t& pred)
 {
    VectorClock::values_t values;
    std::copy_if(clock.cbegin(), clock.cend(), std::inserter(values, values.end()), pred);
@@ -2,6 +2,7 @@
 
 #include "fixed_size_vector.hpp"
 
+#include <iosfwd>
 #include <set>
 
 //--------------------------------------------------------------------------------------------------
@@ -13,6 +14,40 @@
 
 namespace exploration {
 
+/// @brief A non-owning, read-only view of the values of a VectorClock, e.g. of a row in a
+/// clock_arena.
+
+class clock_view
+{
+public:
+   using value_t = int;
+   using const_iterator = const value_t*;
+
+   clock_view(const value_t* data, const std::size_t size)
+   : mData(data)
+   , mSize(size)
+   {
+   }
+
+   std::size_t size() const { return mSize; }
+   const value_t& operator[](const std::size_t i) const { return mData[i]; }
+
+   const_iterator begin() const { return mData; }
+   const_iterator end() const { return mData + mSize; }
+   const_iterator cbegin() const { return mData; }
+   const_iterator cend() const { return mData + mSize; }
+
+private:
+   const value_t* mData;
+   std::size_t mSize;
+
+}; // end class clock_view
+
+std::ostream& operator<<(std::ostream&, const clock_view&);
+
+//--------------------------------------------------------------------------------------------------
+
+
 /// Let P be a program with threads from Tids and let E be an Execution of P. A
 /// VectorClock associated with the post State of a Transition t in E stores for each
 /// Thread::tid_t tid in Tids the index of the last Transition of that Thread in E
@@ -33,37 +68,46 @@ public:
    /// @brief Constructs an n-size VectorClock from the first n values of other. If other's size is 
    /// less than n, the last n-other.size values of the new VectorClock are initialized with 0.
    
-   VectorClock(const VectorClock& other, std::size_t n);
+   VectorClock(const clock_view& other, std::size_t n);
+
+   /// @brief Returns a view of the values of this VectorClock, which is valid as long as this
+   /// VectorClock is.
+
+   operator clock_view() const;
+
+   /// @brief Overwrites the values of this VectorClock with those of other, without reallocating.
+
+   void assign(const clock_view& other);
 
    /// @brief Transforms this VectorClock into max(*this, other) =
    /// <max(*this[0], other[0]), ..., max(*this[mSize-1], other[mSize-1])>
 
-   void max(const VectorClock& other);
+   void max(const clock_view& other);
 
    /// @brief Transforms this VectorClock into gr(*this, other) =
    /// <gr(*this[0], other[0], ..., gr(*this[mSize-1], other[mSize-1])>,
    /// where gr(*this[i], other[i]) = *this[i] if *this[i] > other[i] and 0 otherwise.
 
-   void filter_values_greater_than(const VectorClock& other);
+   void filter_values_greater_than(const clock_view& other);
 
 }; // end class VectorClock
 
 //--------------------------------------------------------------------------------------------------
 
 
-VectorClock::value_t min_element(const VectorClock& clock);
+VectorClock::value_t min_element(const clock_view& clock);
 
-VectorClock::value_t max_element(const VectorClock& clock);
+VectorClock::value_t max_element(const clock_view& clock);
 
 using value_predicate_t = std::function<bool(const VectorClock::value_t&)>;
 
 /// @brief Returns { i | pred(clock[i]) }.
 
-VectorClock::indices_t indices_such_that(const VectorClock& clock, const value_predicate_t& pred);
+VectorClock::indices_t indices_such_that(const clock_view& clock, const value_predicate_t& pred);
 
 /// @brief Returns { clock[i] | pred(clock[i]) }.
 
-VectorClock::values_t values_such_that(const VectorClock& clock, const value_predicate_t& pred);
+VectorClock::values_t values_such_that(const clock_view& clock, const value_predicate_t& pred);
 
 //--------------------------------------------------------------------------------------------------
 
@@ -0,0 +1,318 @@
+
+#include "vector_clock_kernels.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define VECTOR_CLOCK_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+
+namespace exploration {
+namespace kernels {
+
+//--------------------------------------------------------------------------------------------------
+
+namespace {
+
+// The loops are inlined into the kernels of every instruction_set, such that the tail of a SIMD
+// kernel is compiled for the same instruction_set as its vector part. Calling a kernel with the
+// legacy SSE encoding from an AVX2 kernel stalls on the transition between the two encodings.
+
+#ifdef __GNUC__
+#define VECTOR_CLOCK_KERNELS_INLINE inline __attribute__((always_inline))
+#else
+#define VECTOR_CLOCK_KERNELS_INLINE inline
+#endif
+
+VECTOR_CLOCK_KERNELS_INLINE void max_loop(value_t* lhs, const value_t* rhs, const std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i)
+   {
+      lhs[i] = std::max(lhs[i], rhs[i]);
+   }
+}
+
+VECTOR_CLOCK_KERNELS_INLINE void filter_loop(value_t* lhs, const value_t* rhs, const std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i)
+   {
+      if (lhs[i] <= rhs[i])
+      {
+         lhs[i] = 0;
+      }
+   }
+}
+
+VECTOR_CLOCK_KERNELS_INLINE value_t min_loop(value_t min, const value_t* values,
+                                             const std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i)
+   {
+      min = std::min(min, values[i]);
+   }
+   return min;
+}
+
+VECTOR_CLOCK_KERNELS_INLINE value_t max_loop(value_t max, const value_t* values,
+                                             const std::size_t n)
+{
+   for (std::size_t i = 0; i < n; ++i)
+   {
+      max = std::max(max, values[i]);
+   }
+   return max;
+}
+
+} // end namespace
+
+//--------------------------------------------------------------------------------------------------
+
+namespace scalar {
+
+void max(value_t* lhs, const value_t* rhs, const std::size_t n)
+{
+   max_loop(lhs, rhs, n);
+}
+
+void filter_values_greater_than(value_t* lhs, const value_t* rhs, const std::size_t n)
+{
+   filter_loop(lhs, rhs, n);
+}
+
+value_t min_element(const value_t* values, const std::size_t n)
+{
+   return min_loop(values[0], values + 1, n - 1);
+}
+
+value_t max_element(const value_t* values, const std::size_t n)
+{
+   return max_loop(values[0], values + 1, n - 1);
+}
+
+} // end namespace scalar
+
+//--------------------------------------------------------------------------------------------------
+
+#ifdef VECTOR_CLOCK_KERNELS_X86
+
+// The kernels use unaligned loads and stores, as the values of a VectorClock are not aligned.
+// Those of a clock_arena row are, which an unaligned load of a whole register handles at the
+// cost of an aligned one.
+
+namespace sse4_1 {
+
+constexpr std::size_t width = 4;
+
+__attribute__((target("sse4.1"))) void max(value_t* lhs, const value_t* rhs, const std::size_t n)
+{
+   std::size_t i = 0;
+   for (; i + width <= n; i += width)
+   {
+      const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+      const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lhs + i), _mm_max_epi32(l, r));
+   }
+   max_loop(lhs + i, rhs + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) void filter_values_greater_than(value_t* lhs,
+                                                                  const value_t* rhs,
+                                                                  const std::size_t n)
+{
+   std::size_t i = 0;
+   for (; i + width <= n; i += width)
+   {
+      const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+      const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lhs + i),
+                       _mm_and_si128(l, _mm_cmpgt_epi32(l, r)));
+   }
+   filter_loop(lhs + i, rhs + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) value_t min_element(const value_t* values, const std::size_t n)
+{
+   if (n < width)
+      return min_loop(values[0], values + 1, n - 1);
+   __m128i min = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+   std::size_t i = width;
+   for (; i + width <= n; i += width)
+   {
+      min = _mm_min_epi32(min, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+   }
+   min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+   min = _mm_min_epi32(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+   return min_loop(_mm_cvtsi128_si32(min), values + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) value_t max_element(const value_t* values, const std::size_t n)
+{
+   if (n < width)
+      return max_loop(values[0], values + 1, n - 1);
+   __m128i max = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+   std::size_t i = width;
+   for (; i + width <= n; i += width)
+   {
+      max = _mm_max_epi32(max, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+   }
+   max = _mm_max_epi32(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(1, 0, 3, 2)));
+   max = _mm_max_epi32(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(2, 3, 0, 1)));
+   return max_loop(_mm_cvtsi128_si32(max), values + i, n - i);
+}
+
+} // end namespace sse4_1
+
+//--------------------------------------------------------------------------------------------------
+
+namespace avx2 {
+
+constexpr std::size_t width = 8;
+
+__attribute__((target("avx2"))) void max(value_t* lhs, const value_t* rhs, const std::size_t n)
+{
+   std::size_t i = 0;
+   for (; i + width <= n; i += width)
+   {
+      const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+      const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i), _mm256_max_epi32(l, r));
+   }
+   max_loop(lhs + i, rhs + i, n - i);
+}
+
+__attribute__((target("avx2"))) void filter_values_greater_than(value_t* lhs, const value_t* rhs,
+                                                                const std::size_t n)
+{
+   std::size_t i = 0;
+   for (; i + width <= n; i += width)
+   {
+      const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+      const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i),
+                          _mm256_and_si256(l, _mm256_cmpgt_epi32(l, r)));
+   }
+   filter_loop(lhs + i, rhs + i, n - i);
+}
+
+__attribute__((target("avx2"))) value_t min_element(const value_t* values, const std::size_t n)
+{
+   if (n < width)
+      return min_loop(values[0], values + 1, n - 1);
+   __m256i min = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+   std::size_t i = width;
+   for (; i + width <= n; i += width)
+   {
+      min = _mm256_min_epi32(min, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+   }
+   __m128i lanes = _mm_min_epi32(_mm256_castsi256_si128(min), _mm256_extracti128_si256(min, 1));
+   lanes = _mm_min_epi32(lanes, _mm_shuffle_epi32(lanes, _MM_SHUFFLE(1, 0, 3, 2)));
+   lanes = _mm_min_epi32(lanes, _mm_shuffle_epi32(lanes, _MM_SHUFFLE(2, 3, 0, 1)));
+   return min_loop(_mm_cvtsi128_si32(lanes), values + i, n - i);
+}
+
+__attribute__((target("avx2"))) value_t max_element(const value_t* values, const std::size_t n)
+{
+   if (n < width)
+      return max_loop(values[0], values + 1, n - 1);
+   __m256i max = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+   std::size_t i = width;
+   for (; i + width <= n; i += width)
+   {
+      max = _mm256_max_epi32(max, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+   }
+   __m128i lanes = _mm_max_epi32(_mm256_castsi256_si128(max), _mm256_extracti128_si256(max, 1));
+   lanes = _mm_max_epi32(lanes, _mm_shuffle_epi32(lanes, _MM_SHUFFLE(1, 0, 3, 2)));
+   lanes = _mm_max_epi32(lanes, _mm_shuffle_epi32(lanes, _MM_SHUFFLE(2, 3, 0, 1)));
+   return max_loop(_mm_cvtsi128_si32(lanes), values + i, n - i);
+}
+
+} // end namespace avx2
+
+#endif
+
+//--------------------------------------------------------------------------------------------------
+
+namespace {
+
+const kernels_t scalar_kernels{&scalar::max, &scalar::filter_values_greater_than,
+                               &scalar::min_element, &scalar::max_element};
+#ifdef VECTOR_CLOCK_KERNELS_X86
+const kernels_t sse4_1_kernels{&sse4_1::max, &sse4_1::filter_values_greater_than,
+                               &sse4_1::min_element, &sse4_1::max_element};
+const kernels_t avx2_kernels{&avx2::max, &avx2::filter_values_greater_than,
+                             &avx2::min_element, &avx2::max_element};
+#endif
+
+} // end namespace
+
+//--------------------------------------------------------------------------------------------------
+
+instruction_set detect()
+{
+#ifdef VECTOR_CLOCK_KERNELS_X86
+   if (supported(instruction_set::avx2))
+      return instruction_set::avx2;
+   if (supported(instruction_set::sse4_1))
+      return instruction_set::sse4_1;
+#endif
+   return instruction_set::scalar;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool supported(const instruction_set set)
+{
+   switch (set)
+   {
+      case instruction_set::scalar:
+         return true;
+#ifdef VECTOR_CLOCK_KERNELS_X86
+      case instruction_set::sse4_1:
+         return __builtin_cpu_supports("sse4.1");
+      case instruction_set::avx2:
+         return __builtin_cpu_supports("avx2");
+#endif
+      default:
+         return false;
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const kernels_t& get(const instruction_set set)
+{
+   /// @pre supported(set)
+   assert(supported(set));
+#ifdef VECTOR_CLOCK_KERNELS_X86
+   if (set == instruction_set::avx2)
+      return avx2_kernels;
+   if (set == instruction_set::sse4_1)
+      return sse4_1_kernels;
+#endif
+   return scalar_kernels;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const kernels_t* active = &scalar_kernels;
+
+namespace {
+
+/// @brief Points active to the kernels for detect() during the dynamic initialization of this
+/// translation unit.
+
+struct select_kernels
+{
+   select_kernels() { active = &get(detect()); }
+
+} selected;
+
+} // end namespace
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace kernels
+} // end namespace exploration
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+
+//--------------------------------------------------------------------------------------------------
+/// @file vector_clock_kernels.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+namespace kernels {
+
+//--------------------------------------------------------------------------------------------------
+
+using value_t = int;
+
+enum class instruction_set
+{
+   scalar,
+   sse4_1,
+   avx2
+};
+
+/// @brief The element-wise operations on VectorClock values, implemented for one
+/// instruction_set. Every operation takes n > 0 values.
+
+struct kernels_t
+{
+   /// @brief lhs[i] := max(lhs[i], rhs[i]).
+   void (*max)(value_t* lhs, const value_t* rhs, std::size_t n);
+
+   /// @brief lhs[i] := lhs[i] > rhs[i] ? lhs[i] : 0.
+   void (*filter_values_greater_than)(value_t* lhs, const value_t* rhs, std::size_t n);
+
+   value_t (*min_element)(const value_t* values, std::size_t n);
+
+   value_t (*max_element)(const value_t* values, std::size_t n);
+};
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Returns the most capable instruction_set that is supported by both the compiler and
+/// the CPU this process runs on.
+
+instruction_set detect();
+
+/// @brief Returns true iff the kernels for the given instruction_set can run on this CPU.
+
+bool supported(const instruction_set set);
+
+/// @brief Returns the kernels for the given instruction_set.
+/// @pre supported(set)
+
+const kernels_t& get(const instruction_set set);
+
+/// @brief The kernels for detect(), which is evaluated once. Until the dynamic initialization
+/// selects them, these are the scalar kernels, so that clocks joined by the static initializers
+/// of other translation units do not depend on the initialization order.
+
+extern const kernels_t* active;
+
+/// @brief Returns *active.
+
+inline const kernels_t& get() { return *active; }
+
+/// @brief Below this number of values, an operation on VectorClock values is not worth the
+/// indirect call of a kernel and runs inline instead.
+
+constexpr std::size_t min_size = 8;
+
+/// @brief The alignment in bytes at which the widest kernels load whole registers.
+
+constexpr std::size_t alignment = 32;
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace kernels
+} // end namespace exploration
@@ -0,0 +1,146 @@
+
+#include "wakeup_tree.hpp"
+
+#include "dependence.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+bool weak_initial(const transition_record& next, const std::vector<transition_record>& sequence)
+{
+   const auto tid = next.tid;
+   const auto first = std::find_if(sequence.begin(), sequence.end(),
+                                   [tid](const auto& transition) { return transition.tid == tid; });
+   const transition_record& initial = first == sequence.end() ? next : *first;
+   return std::none_of(sequence.begin(), first, [&initial](const auto& transition) {
+      return Dependence::dependent(transition, initial);
+   });
+}
+
+//--------------------------------------------------------------------------------------------------
+
+tid_set wakeup_tree::children() const
+{
+   tid_set children{};
+   for (const auto& child : mChildren)
+   {
+      children.insert(child.transition.tid);
+   }
+   return children;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool wakeup_tree::contains(const tid_t tid) const
+{
+   return find(mChildren, tid) != mChildren.end();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+wakeup_tree::tid_t wakeup_tree::first() const
+{
+   /// @pre !empty()
+   assert(!empty());
+   return mChildren.front().transition.tid;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+wakeup_tree wakeup_tree::subtree(const tid_t tid) const
+{
+   const auto child = find(mChildren, tid);
+   return child == mChildren.end() ? wakeup_tree() : wakeup_tree(child->children);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+wakeup_tree::sequence_t wakeup_tree::branch(const tid_t tid) const
+{
+   /// @pre contains(tid)
+   assert(contains(tid));
+   sequence_t branch{};
+   for (auto child = find(mChildren, tid); ; child = child->children.begin())
+   {
+      branch.push_back(child->transition);
+      if (child->children.empty())
+      {
+         return branch;
+      }
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void wakeup_tree::add_leaf(const transition_record& next)
+{
+   if (!contains(next.tid))
+   {
+      mChildren.push_back({next, {}});
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void wakeup_tree::remove(const tid_t tid)
+{
+   const auto child = find(mChildren, tid);
+   if (child != mChildren.end())
+   {
+      mChildren.erase(child);
+   }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+bool wakeup_tree::insert(sequence_t sequence)
+{
+   std::vector<node>* nodes = &mChildren;
+   while (!sequence.empty())
+   {
+      const auto child = std::find_if(nodes->begin(), nodes->end(), [&sequence](const auto& node) {
+         return weak_initial(node.transition, sequence);
+      });
+      if (child == nodes->end())
+      {
+         for (const auto& transition : sequence)
+         {
+            nodes->push_back({transition, {}});
+            nodes = &nodes->back().children;
+         }
+         return true;
+      }
+      if (child->children.empty())
+      {
+         return false;
+      }
+      const auto tid = child->transition.tid;
+      const auto first =
+         std::find_if(sequence.begin(), sequence.end(),
+                      [tid](const auto& transition) { return transition.tid == tid; });
+      if (first != sequence.end())
+      {
+         sequence.erase(first);
+      }
+      nodes = &child->children;
+   }
+   return false;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::vector<wakeup_tree::node>::const_iterator wakeup_tree::find(const std::vector<node>& nodes,
+                                                                 const tid_t tid)
+{
+   return std::find_if(nodes.begin(), nodes.end(),
+                       [tid](const auto& node) { return node.transition.tid == tid; });
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
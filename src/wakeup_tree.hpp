@@ -0,0 +1,101 @@
+#pragma once
+
+#include "tid_set.hpp"
+#include "transition_record.hpp"
+
+#include "thread.hpp"
+
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file wakeup_tree.hpp
+/// @author Susanne van den Elsen
+/// @date 2017
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Returns true iff next.tid is a weak initial of sequence after a state in which the next
+/// Transition of next.tid is next, as defined in @cite abdulla-popl-14, i.e. iff either next.tid
+/// occurs in sequence and its first Transition in sequence is not preceded by a dependent
+/// Transition in sequence, or next.tid does not occur in sequence and next is independent of every
+/// Transition in sequence.
+
+bool weak_initial(const transition_record& next, const std::vector<transition_record>& sequence);
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief An ordered tree of Transitions, of which every branch is a sequence that is to be
+/// explored from the state to which the wakeup_tree belongs, as described in
+/// @cite abdulla-popl-14. The children of a node are ordered by insertion and have distinct
+/// threads, and are explored from left to right.
+
+class wakeup_tree
+{
+public:
+   using tid_t = program_model::Thread::tid_t;
+   using sequence_t = std::vector<transition_record>;
+
+   wakeup_tree() = default;
+
+   bool empty() const { return mChildren.empty(); }
+
+   /// @brief Returns the threads of the children of the root.
+
+   tid_set children() const;
+
+   bool contains(const tid_t tid) const;
+
+   /// @brief Returns the thread of the leftmost child of the root.
+   /// @pre !empty()
+
+   tid_t first() const;
+
+   /// @brief Returns the subtree rooted at the child of tid, which is empty if the child is a leaf
+   /// or if there is no child of tid.
+
+   wakeup_tree subtree(const tid_t tid) const;
+
+   /// @brief Returns the Transitions along the leftmost branch starting with the child of tid.
+   /// @pre contains(tid)
+
+   sequence_t branch(const tid_t tid) const;
+
+   /// @brief Adds next as the rightmost child of the root if there is no child of next.tid.
+
+   void add_leaf(const transition_record& next);
+
+   /// @brief Removes the child of tid and its subtree.
+
+   void remove(const tid_t tid);
+
+   /// @brief Inserts sequence, unless a branch of this wakeup_tree already covers it.
+   /// @details Descends into the leftmost child whose thread is a weak initial of the remainder of
+   /// sequence, removing that thread's first Transition from the remainder. Reaching a leaf or an
+   /// empty remainder means sequence is covered. Otherwise, the remainder is added as the rightmost
+   /// branch below the node where the descent stopped.
+   /// @returns true iff this wakeup_tree changed.
+
+   bool insert(sequence_t sequence);
+
+private:
+   struct node
+   {
+      transition_record transition;
+      std::vector<node> children;
+   };
+
+   std::vector<node> mChildren;
+
+   explicit wakeup_tree(std::vector<node> children) : mChildren(std::move(children)) {}
+
+   static std::vector<node>::const_iterator find(const std::vector<node>& nodes, const tid_t tid);
+
+}; // end class wakeup_tree
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace exploration
@@ -5,11 +5,18 @@
 #include <bound_functions/preemptions.hpp>
 #include <depth_first_search.hpp>
 #include <exploration.hpp>
+#include <instrumentation_cache.hpp>
+#include <iterative_deepening.hpp>
+#include <parallel_exploration.hpp>
 
 #include <replay.hpp>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
 
 namespace exploration {
 namespace test {
@@ -51,5 +58,237 @@ INSTANTIATE_TEST_CASE_P(DfsSmokeTests, DfsSmokeTest,
 
 //--------------------------------------------------------------------------------------------------
 
+struct ParallelBoundedSearchTest : public ::testing::TestWithParam<NrExecutionsTestData>
+{
+   boost::filesystem::path test_output_dir() const
+   {
+      return detail::test_data_dir / GetParam().test_program.filename() /
+             boost::filesystem::path("0" + GetParam().optimization_level) / "bounded_parallel";
+   }
+}; // end struct ParallelBoundedSearchTest
+
+
+TEST_P(ParallelBoundedSearchTest, ParallelExploresSameNrOfExecutionsAsSerial)
+{
+   using mode_t = depth_first_search<bound<bound_functions::Preemptions>>;
+   const auto program = detail::test_programs_dir / GetParam().test_program;
+   const Settings settings{false, false, scheduler::timeout_t{200}};
+
+   Exploration<mode_t> serial(program, GetParam().expected_nr_executions + 1, 1);
+   serial.set_settings(settings);
+   serial.run({}, GetParam().optimization_level, GetParam().compiler_options,
+              test_output_dir() / "serial");
+
+   const auto parallel = parallel::run<mode_t>(
+      3, program, GetParam().expected_nr_executions + 1, settings, GetParam().optimization_level,
+      GetParam().compiler_options, test_output_dir() / "parallel", 1);
+
+   EXPECT_EQ(serial.statistics().nr_explorations(), GetParam().expected_nr_executions);
+   EXPECT_EQ(parallel.nr_explorations(), GetParam().expected_nr_executions);
+}
+
+
+TEST_P(ParallelBoundedSearchTest, ConcurrentJobsShareTheBudget)
+{
+   using mode_t = depth_first_search<bound<bound_functions::Preemptions>>;
+   const unsigned int max_nr_explorations = GetParam().expected_nr_executions / 2;
+
+   const auto parallel = parallel::run<mode_t>(
+      3, detail::test_programs_dir / GetParam().test_program, max_nr_explorations,
+      {false, false, scheduler::timeout_t{200}}, GetParam().optimization_level,
+      GetParam().compiler_options, test_output_dir() / "budget", 1);
+
+   // A job that spends its share drops the rest of its subtree, so fewer explorations are possible
+   EXPECT_LE(parallel.nr_explorations(), max_nr_explorations);
+   EXPECT_GT(parallel.nr_explorations(), 0u);
+}
+
+
+// The writer's write and the two reads of each of the two readers interleave in 18 ways with at
+// most one preemption
+INSTANTIATE_TEST_CASE_P(ParallelBoundedSearchTests, ParallelBoundedSearchTest,
+                        ::testing::Values(NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c",
+                                                               "0", "", 18}));
+
+//--------------------------------------------------------------------------------------------------
+
+struct IterativeDeepeningTest : public ::testing::TestWithParam<NrExecutionsTestData>
+{
+   boost::filesystem::path test_output_dir() const
+   {
+      return detail::test_data_dir / GetParam().test_program.filename() /
+             boost::filesystem::path("0" + GetParam().optimization_level) / "iterative";
+   }
+}; // end struct IterativeDeepeningTest
+
+
+TEST_P(IterativeDeepeningTest, LevelsUpToBoundExploreSameNrOfExecutionsAsBoundedSearch)
+{
+   using mode_t = depth_first_search<bound<bound_functions::Preemptions>>;
+   const auto program = detail::test_programs_dir / GetParam().test_program;
+   const Settings settings{false, false, scheduler::timeout_t{200}};
+   const int max_bound = 2;
+
+   const auto levels = iterative_deepening<bound_functions::Preemptions>(
+      program, GetParam().expected_nr_executions, max_bound, settings,
+      GetParam().optimization_level, GetParam().compiler_options, test_output_dir() / "levels");
+
+   unsigned int nr_explorations = 0;
+   for (int bound_value = 0; bound_value < static_cast<int>(levels.size()); ++bound_value)
+   {
+      nr_explorations += levels[bound_value].nr_explorations();
+      Exploration<mode_t> bounded(program, GetParam().expected_nr_executions, bound_value);
+      bounded.set_settings(settings);
+      bounded.run({}, GetParam().optimization_level, GetParam().compiler_options,
+                  test_output_dir() / ("bounded-" + std::to_string(bound_value)));
+
+      EXPECT_EQ(bounded.statistics().nr_explorations(), nr_explorations);
+   }
+}
+
+
+INSTANTIATE_TEST_CASE_P(IterativeDeepeningTests, IterativeDeepeningTest,
+                        ::testing::Values(NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c",
+                                                               "0", "", 2000}));
+
+//--------------------------------------------------------------------------------------------------
+
+struct BudgetTest : public ::testing::TestWithParam<NrExecutionsTestData>
+{
+   boost::filesystem::path test_output_dir() const
+   {
+      return detail::test_data_dir / GetParam().test_program.filename() /
+             boost::filesystem::path("0" + GetParam().optimization_level) / "budget";
+   }
+}; // end struct BudgetTest
+
+
+TEST_P(BudgetTest, ExhaustedTimeBudgetStopsExplorationAndWritesFrontier)
+{
+   using mode_t = depth_first_search<bound<bound_functions::Preemptions>>;
+   const auto program = detail::test_programs_dir / GetParam().test_program;
+   const unsigned int nr_explorations = 5;
+
+   Exploration<mode_t> dfs(program, GetParam().expected_nr_executions,
+                           std::numeric_limits<int>::max());
+   dfs.set_settings({false, false, scheduler::timeout_t{200}});
+   dfs.set_iteration_hook([&dfs, nr_explorations]() {
+      if (dfs.statistics().nr_explorations() == nr_explorations)
+         dfs.set_settings({false, false, scheduler::timeout_t{200},
+                           std::chrono::steady_clock::now()});
+   });
+   dfs.run({}, GetParam().optimization_level, GetParam().compiler_options,
+           test_output_dir() / "time");
+
+   EXPECT_EQ(dfs.statistics().nr_explorations(), nr_explorations);
+   ASSERT_TRUE(dfs.exhausted_budget());
+   EXPECT_EQ(*dfs.exhausted_budget(), "time");
+   EXPECT_TRUE(boost::filesystem::exists(test_output_dir() / "time" / "frontier.txt"));
+}
+
+
+TEST_P(BudgetTest, ExceededMemoryBudgetStopsExploration)
+{
+   using mode_t = depth_first_search<bound<bound_functions::Preemptions>>;
+
+   Exploration<mode_t> dfs(detail::test_programs_dir / GetParam().test_program,
+                           GetParam().expected_nr_executions, std::numeric_limits<int>::max());
+   dfs.set_settings({false, false, scheduler::timeout_t{200}, boost::none, std::size_t{0}});
+   dfs.run({}, GetParam().optimization_level, GetParam().compiler_options,
+           test_output_dir() / "memory");
+
+   EXPECT_EQ(dfs.statistics().nr_explorations(), 0u);
+   ASSERT_TRUE(dfs.exhausted_budget());
+   EXPECT_EQ(*dfs.exhausted_budget(), "memory");
+
+   // Nothing was replayed, so the frontier is the initial schedule
+   std::ostringstream expected;
+   expected << scheduler::schedule_t{} << std::endl;
+   std::ifstream ifs((test_output_dir() / "memory" / "frontier.txt").string());
+   ASSERT_TRUE(ifs);
+   EXPECT_EQ(std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()),
+             expected.str());
+}
+
+
+INSTANTIATE_TEST_CASE_P(BudgetTests, BudgetTest,
+                        ::testing::Values(NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c",
+                                                               "0", "", 2000}));
+
+//--------------------------------------------------------------------------------------------------
+
+struct InstrumentationCacheTestData
+{
+   boost::filesystem::path test_program;
+   std::string optimization_level;
+   std::string compiler_options;
+
+}; // end struct InstrumentationCacheTestData
+
+
+struct InstrumentationCacheTest : public ::testing::TestWithParam<InstrumentationCacheTestData>
+{
+   boost::filesystem::path test_output_dir() const
+   {
+      return detail::test_data_dir / GetParam().test_program.filename() /
+             boost::filesystem::path("0" + GetParam().optimization_level) / "cache";
+   }
+}; // end struct InstrumentationCacheTest
+
+
+TEST_P(InstrumentationCacheTest, KeyDependsOnProgramAndOptions)
+{
+   const auto program = (detail::test_programs_dir / GetParam().test_program).string();
+   const auto key = instrumentation_cache::key(program, GetParam().optimization_level,
+                                               GetParam().compiler_options);
+
+   EXPECT_EQ(instrumentation_cache::key(program, GetParam().optimization_level,
+                                        GetParam().compiler_options),
+             key);
+   EXPECT_NE(instrumentation_cache::key(program, "3", GetParam().compiler_options), key);
+   EXPECT_NE(instrumentation_cache::key(program, GetParam().optimization_level, "-DNDEBUG"),
+             key);
+}
+
+
+TEST_P(InstrumentationCacheTest, SecondRunReusesInstrumentedExecutable)
+{
+   using mode_t = depth_first_search<bound<bound_functions::Preemptions>>;
+   const auto program = detail::test_programs_dir / GetParam().test_program;
+   boost::filesystem::remove_all(test_output_dir());
+
+   Settings settings{false, false, scheduler::timeout_t{200}};
+   settings.instrumentation_cache = test_output_dir() / "cache";
+
+   Exploration<mode_t> first(program, 1, std::numeric_limits<int>::max());
+   first.set_settings(settings);
+   first.run({}, GetParam().optimization_level, GetParam().compiler_options,
+             test_output_dir() / "first");
+
+   const auto executable =
+      test_output_dir() / "cache" /
+      instrumentation_cache::key(program.string(), GetParam().optimization_level,
+                                 GetParam().compiler_options) /
+      GetParam().test_program.stem();
+   ASSERT_TRUE(boost::filesystem::exists(executable));
+   const auto instrumented_at = boost::filesystem::last_write_time(executable);
+
+   Exploration<mode_t> second(program, 1, std::numeric_limits<int>::max());
+   second.set_settings(settings);
+   second.run({}, GetParam().optimization_level, GetParam().compiler_options,
+              test_output_dir() / "second");
+
+   EXPECT_EQ(second.statistics().nr_explorations(), 1u);
+   EXPECT_EQ(boost::filesystem::last_write_time(executable), instrumented_at);
+   EXPECT_FALSE(boost::filesystem::exists(test_output_dir() / "second" / "instrumented"));
+}
+
+
+INSTANTIATE_TEST_CASE_P(InstrumentationCacheTests, InstrumentationCacheTest,
+                        ::testing::Values(InstrumentationCacheTestData{
+                           "benchmarks/readers_nonpreemptive.c", "0", ""}));
+
+//--------------------------------------------------------------------------------------------------
+
 } // end namespace test
 } // end namespace exploration
@@ -1,15 +1,26 @@
 
 #include <test_helpers.hpp>
 
+#include <bound_functions/preemptions.hpp>
 #include <depth_first_search.hpp>
 #include <dpor.hpp>
 #include <exploration.hpp>
+#include <parallel_exploration.hpp>
+#include <sufficient_sets/bound_persistent_set.hpp>
+#include <sufficient_sets/optimal_set.hpp>
 #include <sufficient_sets/persistent_set.hpp>
+#include <sufficient_sets/source_set.hpp>
 
 #include <replay.hpp>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+
 
 namespace exploration {
 namespace test {
@@ -36,6 +47,16 @@ TEST_P(DporNrExecutionsTest, NrExecutionsIsAsExpected)
    ASSERT_EQ(dpor.statistics().nr_explorations(), GetParam().expected_nr_executions);
 }
 
+TEST_P(DporNrExecutionsTest, ParallelNrExecutionsIsAsExpected)
+{
+   const auto statistics = parallel::run<depth_first_search<dpor<Persistent>>>(
+      3, detail::test_programs_dir / GetParam().test_program,
+      GetParam().expected_nr_executions + 1, Settings(), GetParam().optimization_level,
+      GetParam().compiler_options, test_output_dir() / "parallel");
+
+   ASSERT_EQ(statistics.nr_explorations(), GetParam().expected_nr_executions);
+}
+
 INSTANTIATE_TEST_CASE_P(
    DporNrExecutionsTests, DporNrExecutionsTest,
    ::testing::Values(NrExecutionsTestData{"shared_memory_access_non_concurrent.cpp", "0",
@@ -49,5 +70,273 @@ INSTANTIATE_TEST_CASE_P(
 
 //--------------------------------------------------------------------------------------------------
 
+/// @brief Backtrack points that a worker adds to states it gave up are forwarded to the
+/// coordinator and explored by another job, such that the parallel exploration sees as many
+/// executions as the serial one.
+
+struct DporForwardingTest : public DporNrExecutionsTest
+{
+   /// @brief Returns the sum of the values of key in the statistics.txt of the workers in dir.
+   static unsigned int sum_over_workers(const boost::filesystem::path& dir, const std::string& key)
+   {
+      unsigned int sum = 0;
+      for (boost::filesystem::directory_iterator it(dir), end; it != end; ++it)
+      {
+         std::ifstream ifs((it->path() / "statistics.txt").string());
+         for (std::string line; std::getline(ifs, line);)
+         {
+            if (line.compare(0, key.size() + 1, key + "\t") == 0)
+               sum += std::stoul(line.substr(key.size() + 1));
+         }
+      }
+      return sum;
+   }
+};
+
+TEST_P(DporForwardingTest, ForwardedBacktrackPointsAreExplored)
+{
+   using mode_t = depth_first_search<dpor<Persistent>>;
+   const auto program = detail::test_programs_dir / GetParam().test_program;
+
+   Exploration<mode_t> serial{program, GetParam().expected_nr_executions + 1};
+   serial.run({}, GetParam().optimization_level, GetParam().compiler_options,
+              test_output_dir() / "serial");
+
+   const auto statistics = parallel::run<mode_t>(
+      2, program, GetParam().expected_nr_executions + 1, Settings(),
+      GetParam().optimization_level, GetParam().compiler_options,
+      test_output_dir() / "forwarding");
+
+   EXPECT_EQ(serial.statistics().nr_explorations(), GetParam().expected_nr_executions);
+   EXPECT_EQ(statistics.nr_explorations(), GetParam().expected_nr_executions);
+   EXPECT_GT(sum_over_workers(test_output_dir() / "forwarding", "nr_forwarded"), 0u);
+}
+
+INSTANTIATE_TEST_CASE_P(DporForwardingTests, DporForwardingTest,
+                        ::testing::Values(NrExecutionsTestData{"forwarded_race.c", "0", "", 3}));
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Source and Optimal assume that threads do not disable each other, i.e. they are only
+/// run on programs without locks.
+
+struct DporSourceNrExecutionsTest : public DporNrExecutionsTest
+{
+};
+
+TEST_P(DporSourceNrExecutionsTest, SourceNrExecutionsIsAsExpected)
+{
+   using dpor_t = Exploration<depth_first_search<dpor<Source>>>;
+   dpor_t dpor{detail::test_programs_dir / GetParam().test_program,
+               GetParam().expected_nr_executions + 1};
+   dpor.run({}, GetParam().optimization_level, GetParam().compiler_options,
+            test_output_dir() / "source");
+
+   ASSERT_EQ(dpor.statistics().nr_explorations(), GetParam().expected_nr_executions);
+}
+
+TEST_P(DporSourceNrExecutionsTest, OptimalNrExecutionsIsAsExpected)
+{
+   using dpor_t = Exploration<depth_first_search<dpor<Optimal>>>;
+   dpor_t dpor{detail::test_programs_dir / GetParam().test_program,
+               GetParam().expected_nr_executions + 1};
+   dpor.run({}, GetParam().optimization_level, GetParam().compiler_options,
+            test_output_dir() / "optimal");
+
+   ASSERT_EQ(dpor.statistics().nr_explorations(), GetParam().expected_nr_executions);
+}
+
+INSTANTIATE_TEST_CASE_P(
+   DporSourceNrExecutionsTests, DporSourceNrExecutionsTest,
+   ::testing::Values(NrExecutionsTestData{"shared_memory_access_non_concurrent.cpp", "0",
+                                              "-std=c++14", 1},
+                     // @cite Abdulla:2014:ODP:2535838.2535845: one execution per order of the
+                     // writer and each reader's read of x[0]
+                     NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c", "0", "", 4}));
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief An Optimal exploration stopped by its deadline lists its unexplored subtrees in
+/// frontier.txt, although its schedules extend the current branch by whole wakeup sequences.
+
+struct DporBudgetTest : public DporNrExecutionsTest
+{
+};
+
+TEST_P(DporBudgetTest, OptimalStoppedByDeadlineWritesFrontier)
+{
+   using dpor_t = Exploration<depth_first_search<dpor<Optimal>>>;
+   const unsigned int nr_explorations = 1;
+   dpor_t dpor{detail::test_programs_dir / GetParam().test_program,
+               GetParam().expected_nr_executions + 1};
+   dpor.set_iteration_hook([&dpor, nr_explorations]() {
+      if (dpor.statistics().nr_explorations() == nr_explorations)
+      {
+         Settings settings;
+         settings.deadline = std::chrono::steady_clock::now();
+         dpor.set_settings(settings);
+      }
+   });
+   dpor.run({}, GetParam().optimization_level, GetParam().compiler_options,
+            test_output_dir() / "optimal_budget");
+
+   EXPECT_EQ(dpor.statistics().nr_explorations(), nr_explorations);
+   ASSERT_TRUE(dpor.exhausted_budget());
+   EXPECT_TRUE(
+      boost::filesystem::exists(test_output_dir() / "optimal_budget" / "frontier.txt"));
+}
+
+INSTANTIATE_TEST_CASE_P(DporBudgetTests, DporBudgetTest,
+                        ::testing::Values(NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c",
+                                                               "0", "", 4}));
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief With a bound that is never exceeded, BoundPersistent explores the same executions as
+/// Persistent.
+
+struct DporBoundPersistentNrExecutionsTest : public DporNrExecutionsTest
+{
+};
+
+TEST_P(DporBoundPersistentNrExecutionsTest, UnboundedNrExecutionsIsAsExpected)
+{
+   using sufficient_set_t = BoundPersistent<bound_functions::Preemptions>;
+   using dpor_t = Exploration<depth_first_search<dpor<sufficient_set_t>>>;
+   dpor_t dpor{detail::test_programs_dir / GetParam().test_program,
+               GetParam().expected_nr_executions + 1, std::numeric_limits<int>::max(),
+               BoundPersistentOptimizations()};
+   dpor.run({}, GetParam().optimization_level, GetParam().compiler_options,
+            test_output_dir() / "bound_persistent");
+
+   ASSERT_EQ(dpor.statistics().nr_explorations(), GetParam().expected_nr_executions);
+}
+
+INSTANTIATE_TEST_CASE_P(
+   DporBoundPersistentNrExecutionsTests, DporBoundPersistentNrExecutionsTest,
+   ::testing::Values(NrExecutionsTestData{"shared_memory_access_non_concurrent.cpp", "0",
+                                              "-std=c++14", 1},
+                     NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c", "0", "", 5}));
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Persistent skips schedules that it predicts to be sleepset blocked, whereas 
+/// BoundPersistent with a bound that is never exceeded replays them. Skipping only sleepset 
+/// blocked schedules leaves the executions that are not blocked, and hence the explored traces, 
+/// unchanged.
+
+struct DporSleepsetBlockedTest : public DporNrExecutionsTest
+{
+   static std::set<std::string> read_lines(const boost::filesystem::path& file)
+   {
+      std::ifstream ifs(file.string());
+      std::set<std::string> lines{};
+      for (std::string line; std::getline(ifs, line);)
+         lines.insert(line);
+      return lines;
+   }
+};
+
+TEST_P(DporSleepsetBlockedTest, PrunedSchedulesAreSleepsetBlocked)
+{
+   using bound_persistent_t = BoundPersistent<bound_functions::Preemptions>;
+   const auto program = detail::test_programs_dir / GetParam().test_program;
+
+   Exploration<depth_first_search<dpor<Persistent>>> pruning{
+      program, GetParam().expected_nr_executions + 1};
+   pruning.run({}, GetParam().optimization_level, GetParam().compiler_options,
+               test_output_dir() / "pruning");
+
+   Exploration<depth_first_search<dpor<bound_persistent_t>>> replaying{
+      program, GetParam().expected_nr_executions + 1, std::numeric_limits<int>::max(),
+      BoundPersistentOptimizations()};
+   replaying.run({}, GetParam().optimization_level, GetParam().compiler_options,
+                 test_output_dir() / "replaying");
+
+   const auto& pruned = pruning.mode().reduction().statistics();
+   const auto& replayed = replaying.mode().reduction().statistics();
+   EXPECT_EQ(pruning.statistics().nr_explorations() - pruned.nr_sleepset_blocked(),
+             GetParam().expected_nr_executions);
+   EXPECT_EQ(replaying.statistics().nr_explorations() - replayed.nr_sleepset_blocked(),
+             GetParam().expected_nr_executions);
+   EXPECT_EQ(pruned.nr_sleepset_blocked() + pruned.nr_sleepset_blocked_pruned(),
+             replayed.nr_sleepset_blocked());
+
+   // The schedules of Persistent are those of BoundPersistent without the pruned ones
+   const auto pruning_schedules = read_lines(test_output_dir() / "pruning" / "schedules.txt");
+   const auto replaying_schedules = read_lines(test_output_dir() / "replaying" / "schedules.txt");
+   EXPECT_TRUE(std::includes(replaying_schedules.begin(), replaying_schedules.end(),
+                             pruning_schedules.begin(), pruning_schedules.end()));
+   EXPECT_EQ(replaying_schedules.size() - pruning_schedules.size(),
+             pruned.nr_sleepset_blocked_pruned());
+}
+
+INSTANTIATE_TEST_CASE_P(
+   DporSleepsetBlockedTests, DporSleepsetBlockedTest,
+   ::testing::Values(
+      // The termination of a enables main, so the schedule that runs a before b is not pruned
+      NrExecutionsTestData{"termination_enables_joiner.c", "0", "", 2},
+      NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c", "0", "", 4}));
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(ExplorationStatisticsTest, StoppedClockAddsToTimeOfEarlierPart)
+{
+   ExplorationStatistics statistics;
+   statistics.add_time(1.5, 2.5);
+   statistics.start_clock();
+   statistics.stop_clock();
+   EXPECT_GE(statistics.time_cpu(), 1.5);
+   EXPECT_GE(statistics.time_wall(), 2.5);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief An exploration that is stopped after nr_explorations and resumed from its checkpoint
+/// explores the same executions, in the same order, as one that is not stopped.
+
+struct DporCheckpointTest : public DporNrExecutionsTest
+{
+   static std::string read(const boost::filesystem::path& file)
+   {
+      std::ifstream ifs(file.string());
+      return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+   }
+};
+
+TEST_P(DporCheckpointTest, ResumedExplorationIsAsUninterrupted)
+{
+   using dpor_t = Exploration<depth_first_search<dpor<Persistent>>>;
+   const auto program = detail::test_programs_dir / GetParam().test_program;
+   Settings settings;
+   settings.checkpoint_interval = std::chrono::seconds(0);
+   const unsigned int nr_explorations = 2;
+
+   dpor_t uninterrupted{program, GetParam().expected_nr_executions + 1};
+   uninterrupted.run({}, GetParam().optimization_level, GetParam().compiler_options,
+                     test_output_dir() / "uninterrupted");
+
+   dpor_t stopped{program, nr_explorations};
+   stopped.set_settings(settings);
+   stopped.run({}, GetParam().optimization_level, GetParam().compiler_options,
+               test_output_dir() / "checkpoint");
+
+   dpor_t resumed{program, GetParam().expected_nr_executions + 1};
+   resumed.set_settings(settings);
+   resumed.resume(test_output_dir() / "checkpoint" / "checkpoint.bin",
+                  GetParam().optimization_level, GetParam().compiler_options,
+                  test_output_dir() / "checkpoint");
+
+   EXPECT_EQ(resumed.statistics().nr_explorations(), GetParam().expected_nr_executions);
+   EXPECT_EQ(read(test_output_dir() / "checkpoint" / "schedules.txt"),
+             read(test_output_dir() / "uninterrupted" / "schedules.txt"));
+}
+
+INSTANTIATE_TEST_CASE_P(DporCheckpointTests, DporCheckpointTest,
+                        ::testing::Values(NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c",
+                                                               "0", "", 5}));
+
+//--------------------------------------------------------------------------------------------------
+
 } // end namespace test
 } // end namespace exploration
@@ -0,0 +1,122 @@
+#include <differential_dpor.hpp>
+#include <test_helpers.hpp>
+
+#include <depth_first_search.hpp>
+#include <exploration.hpp>
+#include <sufficient_sets/persistent_set.hpp>
+#include <tree_clock.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace exploration {
+namespace test {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Explores a test program with differential_dpor, which compares the happens-before
+/// analysis with its baselines along every explored execution. The parameter is the test program.
+
+struct HappensBeforeDifferentialTest : public ::testing::TestWithParam<std::string>
+{
+   static constexpr unsigned int max_nr_explorations = 100;
+
+   boost::filesystem::path test_output_dir() const
+   {
+      return detail::test_data_dir / boost::filesystem::path(GetParam()).filename() /
+             "happens_before";
+   }
+
+   /// @brief Returns the differences that the given check of differential_dpor finds, on a
+   /// relation that joins clock_t clocks. The exploration is written to test_output_dir() /
+   /// output_dir, or to test_output_dir() / check if output_dir is empty.
+
+   template <typename sufficient_set_t, typename clock_t = VectorClock>
+   std::vector<std::string> differences(const std::string& check,
+                                        const bool filter_thread_local = false,
+                                        const std::string& output_dir = "") const
+   {
+      using mode_t = depth_first_search<differential_dpor<sufficient_set_t, clock_t>>;
+      Exploration<mode_t> exploration{detail::test_programs_dir / GetParam(),
+                                      max_nr_explorations, filter_thread_local};
+      exploration.run({}, "0", "", test_output_dir() / (output_dir.empty() ? check : output_dir));
+      EXPECT_GT(exploration.statistics().nr_explorations(), 0u);
+      return exploration.mode().reduction().differences(check);
+   }
+};
+
+TEST_P(HappensBeforeDifferentialTest, JoinedClocksEqualScannedClocks)
+{
+   const auto found = differences<Persistent>("clocks");
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+}
+
+TEST_P(HappensBeforeDifferentialTest, FrontierAfterPopBackEqualsRebuiltFrontier)
+{
+   const auto found = differences<Persistent>("frontier");
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+}
+
+/// @brief The tree_clock relation is only used by dpor with TREE_CLOCKS, hence it is checked on
+/// the relation of differential_dpor instead.
+
+TEST_P(HappensBeforeDifferentialTest, JoinedTreeClocksEqualScannedClocks)
+{
+   const auto found = differences<Persistent, tree_clock>("clocks", false, "tree_clocks");
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+}
+
+TEST_P(HappensBeforeDifferentialTest, TreeClockFrontierAfterPopBackEqualsRebuiltFrontier)
+{
+   const auto found = differences<Persistent, tree_clock>("frontier", false, "tree_frontier");
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+}
+
+TEST_P(HappensBeforeDifferentialTest, RecordOverloadsEqualInstructionOverloads)
+{
+   const auto found = differences<Persistent>("records");
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+}
+
+/// @brief The thread-local-objects option only enables HappensBefore::filter_thread_local.
+
+TEST_P(HappensBeforeDifferentialTest, ThreadLocalFilteringAnswersQueriesAsUnfiltered)
+{
+   const auto found = differences<Persistent>("thread_local");
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+}
+
+TEST_P(HappensBeforeDifferentialTest, ThreadLocalFilteringExploresTheSameSchedules)
+{
+   const auto read = [this](const std::string& output_dir) {
+      std::ifstream ifs((test_output_dir() / output_dir / "schedules.txt").string());
+      return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+   };
+   const auto found = differences<Persistent>("thread_local", true, "filtered");
+   differences<Persistent>("thread_local", false, "unfiltered");
+
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+   EXPECT_FALSE(read("filtered").empty());
+   EXPECT_EQ(read("filtered"), read("unfiltered"));
+}
+
+TEST_P(HappensBeforeDifferentialTest, SkippedThreadsHaveUnchangedBacktrackPoints)
+{
+   const auto found = differences<Persistent>("unchanged");
+   EXPECT_TRUE(found.empty()) << found.size() << " differences, the first " << found.front();
+}
+
+INSTANTIATE_TEST_CASE_P(HappensBeforeDifferentialTests, HappensBeforeDifferentialTest,
+                        ::testing::Values("benchmarks/readers_nonpreemptive.c", "forwarded_race.c",
+                                          "shared_and_local_accesses.c",
+                                          "termination_enables_joiner.c"));
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace test
+} // end namespace exploration
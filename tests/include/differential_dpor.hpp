@@ -0,0 +1,321 @@
+#pragma once
+
+#include <dpor.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//--------------------------------------------------------------------------------------------------
+/// @file differential_dpor.hpp
+/// @brief A dpor that checks the computations of its happens-before analysis against the
+/// computations they replaced, along the executions that it explores.
+/// @date 2026
+//--------------------------------------------------------------------------------------------------
+
+
+namespace exploration {
+namespace test {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Exposes the relation of a HappensBefore that joins clock_t clocks and computes the
+/// baselines to compare it with.
+
+template <typename clock_t>
+class inspected_happens_before : public HappensBefore<Dependence, clock_t>
+{
+public:
+   using base_t = HappensBefore<Dependence, clock_t>;
+   using index_t = typename base_t::index_t;
+   using instruction_t = typename base_t::instruction_t;
+
+   explicit inspected_happens_before(const program_model::Execution& execution)
+   : base_t(execution)
+   {
+   }
+
+   /// @brief Returns the clock of Transition i in the relation.
+
+   std::vector<int> clock_of(const index_t i) const
+   {
+      const clock_view clock = (*this)[i];
+      return {clock.begin(), clock.end()};
+   }
+
+   /// @brief Returns the clocks of the last Transition of every thread.
+
+   std::vector<std::vector<int>> frontier() const
+   {
+      std::vector<std::vector<int>> frontier;
+      for (const auto& clock : this->mFrontier)
+         frontier.emplace_back(clock.begin(), clock.end());
+      return frontier;
+   }
+
+   /// @brief Returns the clock of instr after pre(mE,i) as the scan of detail::create_clock
+   /// computes it.
+
+   std::vector<int> scanned_clock(const index_t i, const transition_record& instr) const
+   {
+      // Keep the statistics of mOperands to those of the relation itself
+      operand_interner operands = this->mOperands;
+      const VectorClock clock = exploration::detail::create_clock<Dependence>(
+         this->mRecords, this->mHB, i, instr, operands);
+      return {clock.begin(), clock.end()};
+   }
+
+   /// @brief Returns the record of Transition i.
+
+   const transition_record& record(const index_t i) const { return this->mRecords[i]; }
+
+   /// @brief Returns the record of instr, interning its operand.
+
+   transition_record decode(const instruction_t& instr) const { return this->record_of(instr); }
+
+}; // end class template inspected_happens_before
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Explores like dpor<sufficient_set_t> and records a difference for every Transition on
+/// which an optimized computation disagrees with its baseline.
+/// @details The checks run on an inspected_happens_before that follows the same updates, pops and
+/// resets as the relation of dpor, because the relation of dpor does not expose its records. It
+/// joins clock_t clocks, which need not be those of dpor.
+
+template <typename sufficient_set_t, typename clock_t = VectorClock>
+class differential_dpor : public dpor<sufficient_set_t>
+{
+public:
+   using base_t = dpor<sufficient_set_t>;
+   using execution_t = typename base_t::execution_t;
+   using transition_t = typename base_t::transition_t;
+   using instruction_t = typename transition_t::instruction_t;
+
+   /// @param filter_thread_local Whether dpor itself collapses the Transitions on thread-local
+   /// operands out of its analysis, as with Settings::thread_local_objects.
+
+   explicit differential_dpor(const execution_t& execution, const bool filter_thread_local = false)
+   : base_t(execution, settings(filter_thread_local))
+   , mInspected(execution)
+   , mFiltered(execution)
+   , mPopped(false)
+   {
+      mFiltered.filter_thread_local(true);
+   }
+
+   void reset()
+   {
+      base_t::reset();
+      mInspected.reset();
+      mFiltered.reset();
+   }
+
+   void update_state(const execution_t& execution, const transition_t& transition)
+   {
+      const auto i = transition.index();
+      const tid_set unchanged = this->unchanged_threads(execution, i);
+      base_t::update_state(execution, transition);
+      check_unchanged(execution, i, unchanged);
+      if (mPopped)
+      {
+         check_frontier(execution, i);
+         mPopped = false;
+      }
+      mInspected.update(i);
+      mFiltered.update(i);
+      check_clocks(execution, i);
+      check_records(execution, i);
+      check_thread_local(execution, i);
+   }
+
+   void pop_back()
+   {
+      base_t::pop_back();
+      mInspected.pop_back();
+      mFiltered.pop_back();
+      mPopped = true;
+   }
+
+   /// @brief Returns a description of every difference found so far by the given check.
+
+   std::vector<std::string> differences(const std::string& check) const
+   {
+      std::vector<std::string> found;
+      std::copy_if(mDifferences.begin(), mDifferences.end(), std::back_inserter(found),
+                   [&check](const auto& difference) {
+                      return difference.compare(0, check.size() + 1, check + ":") == 0;
+                   });
+      return found;
+   }
+
+private:
+   static Settings settings(const bool thread_local_objects)
+   {
+      Settings settings;
+      settings.thread_local_objects = thread_local_objects;
+      return settings;
+   }
+
+   inspected_happens_before<clock_t> mInspected;
+   /// @brief Follows mInspected, but collapses the Transitions on thread-local operands.
+   inspected_happens_before<clock_t> mFiltered;
+   std::vector<std::string> mDifferences;
+   /// @brief Whether Transitions were popped since the last update.
+   bool mPopped;
+   /// @brief The backtrack points of all threads at the last index that update_state analysed.
+   BacktrackPoints mPoints;
+
+   void difference(const std::string& check, const std::string& what, const std::size_t i)
+   {
+      std::ostringstream os;
+      os << check << ": " << what << " at " << i;
+      mDifferences.push_back(os.str());
+   }
+
+   /// @brief Compares the clock of execution[i], which is joined from the access index, and the
+   /// clocks of the next instructions of the other threads after pre(execution, i), from which
+   /// max_dependent starts, with the scan of detail::create_clock.
+
+   void check_clocks(const execution_t& execution, const std::size_t i)
+   {
+      if (mInspected.clock_of(i) != mInspected.scanned_clock(i, mInspected.record(i)))
+         difference("clocks", "clock", i);
+      const auto& pre = execution[i].pre();
+      for (auto next = pre.next_cbegin(); next != pre.next_cend(); ++next)
+      {
+         const transition_record record = mInspected.decode(next->second.instr);
+         if (record.tid == mInspected.record(i).tid)
+            continue;
+         std::vector<int> scanned = mInspected.scanned_clock(i, record);
+         scanned[record.tid] = 0;
+         const auto max = *std::max_element(scanned.begin(), scanned.end());
+         if (mInspected.max_dependent(i, next->second.instr, false, false) != max)
+            difference("clocks", "max_dependent of thread " + std::to_string(record.tid), i);
+      }
+   }
+
+   /// @brief Compares the relation and the frontier on the prefix retained after popping, which
+   /// were rolled back by pop_back, with those rebuilt from scratch on pre(execution, i).
+
+   void check_frontier(const execution_t& execution, const std::size_t i)
+   {
+      inspected_happens_before<clock_t> rebuilt(execution);
+      for (std::size_t j = 1; j < i; ++j)
+      {
+         rebuilt.update(j);
+         if (rebuilt.clock_of(j) != mInspected.clock_of(j))
+            difference("frontier", "clock " + std::to_string(j), i);
+      }
+      if (rebuilt.frontier() != mInspected.frontier())
+         difference("frontier", "frontier", i);
+   }
+
+   /// @brief Compares the overloads of Dependence on the records of execution[i] and of the next
+   /// instructions after pre(execution, i) with the overloads on the instructions, for the pairs
+   /// with the Transitions in pre+(execution, i).
+
+   void check_records(const execution_t& execution, const std::size_t i)
+   {
+      const auto& pre = execution[i].pre();
+      std::vector<std::pair<instruction_t, transition_record>> instructions{
+         {execution[i].instr(), mInspected.record(i)}};
+      for (auto next = pre.next_cbegin(); next != pre.next_cend(); ++next)
+         instructions.emplace_back(next->second.instr, mInspected.decode(next->second.instr));
+      for (const auto& instruction : instructions)
+      {
+         const auto tid = boost::apply_visitor(program_model::get_tid(), instruction.first);
+         if (instruction.second.tid != tid)
+            difference("records", "tid of thread " + std::to_string(tid), i);
+         if (Dependence::exclusive(instruction.second) != Dependence::exclusive(instruction.first))
+            difference("records", "exclusive of thread " + std::to_string(tid), i);
+         for (std::size_t j = 1; j <= i; ++j)
+         {
+            const auto& instr_j = execution[j].instr();
+            const transition_record& record_j = mInspected.record(j);
+            if (Dependence::dependent(record_j, instruction.second) !=
+                   Dependence::dependent(instr_j, instruction.first) ||
+                Dependence::coenabled(record_j, instruction.second) !=
+                   Dependence::coenabled(instr_j, instruction.first))
+            {
+               difference("records", "thread " + std::to_string(tid) + " with " +
+                                        std::to_string(j), i);
+            }
+         }
+      }
+   }
+
+   /// @brief Compares the answers of mFiltered to the queries of the sufficient sets at index i
+   /// with those of mInspected.
+
+   void check_thread_local(const execution_t& execution, const std::size_t i)
+   {
+      const auto& instr = execution[i].instr();
+      if (mFiltered.covering(i, instr) != mInspected.covering(i, instr))
+         difference("thread_local", "covering", i);
+      const auto& pre = execution[i].pre();
+      for (auto next = pre.next_cbegin(); next != pre.next_cend(); ++next)
+      {
+         const auto& next_instr = next->second.instr;
+         const std::string thread = " of thread " + std::to_string(next->first);
+         if (mFiltered.max_dependent(i, next_instr, true, true) !=
+             mInspected.max_dependent(i, next_instr, true, true))
+         {
+            difference("thread_local", "max_dependent" + thread, i);
+         }
+         if (mFiltered.max_dependent_per_thread(i, next_instr) !=
+             mInspected.max_dependent_per_thread(i, next_instr))
+         {
+            difference("thread_local", "max_dependent_per_thread" + thread, i);
+         }
+      }
+   }
+
+   /// @brief Checks that the backtrack points at index i of the threads that dpor skipped as
+   /// unchanged equal their points at index i-1, and that adding them does not change any
+   /// backtrack set.
+
+   void check_unchanged(const execution_t& execution, const std::size_t i,
+                        const tid_set& unchanged)
+   {
+      if (!sufficient_set_t::skip_unchanged_threads)
+         return;
+      const BacktrackPoints points = sufficient_set_t::backtrack_points(execution, i, this->mHB);
+      const auto points_of = [](const BacktrackPoints& points, const int tid) {
+         std::vector<int> indices;
+         for (const auto& point : points)
+         {
+            if (point.tid == tid)
+               indices.push_back(point.index);
+         }
+         return indices;
+      };
+      auto state = this->mState;
+      for (const auto& tid : unchanged)
+      {
+         const std::string thread = "thread " + std::to_string(tid);
+         if (points_of(points, tid) != points_of(mPoints, tid))
+            difference("unchanged", thread, i);
+         for (const auto& point : points)
+         {
+            if (point.tid == tid && static_cast<std::size_t>(point.index) > this->mFloor)
+               sufficient_set_t::add_backtrack_point(execution, i, state, this->mHB, point);
+         }
+      }
+      for (std::size_t index = 0; index < state.size(); ++index)
+      {
+         if (state[index].backtrack() != this->mState[index].backtrack())
+            difference("unchanged", "backtrack set " + std::to_string(index), i);
+      }
+      mPoints = points;
+   }
+
+}; // end class template differential_dpor
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace test
+} // end namespace exploration
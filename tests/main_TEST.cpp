@@ -1,7 +1,13 @@
 
 #include "dfs_TEST.cpp"
 #include "dpor_TEST.cpp"
+#include "happens_before_TEST.cpp"
+#include "operand_interner_TEST.cpp"
+#include "random_search_TEST.cpp"
+#include "tid_set_TEST.cpp"
+#include "tree_clock_TEST.cpp"
 #include "vector_clock_TEST.cpp"
+#include "wakeup_tree_TEST.cpp"
 
 #include <gtest/gtest.h>
 
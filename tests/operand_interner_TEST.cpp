@@ -0,0 +1,88 @@
+#include <test_helpers.hpp>
+
+#include <depth_first_search.hpp>
+#include <dpor.hpp>
+#include <exploration.hpp>
+#include <operand_interner.hpp>
+#include <sufficient_sets/persistent_set.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace exploration {
+namespace test {
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(OperandInternerTest, InterningAgainReturnsTheSameId)
+{
+   operand_interner operands;
+   const operand_interner::operand_t operand{};
+
+   const auto id = operands.intern(operand);
+   ASSERT_EQ(id, 0u);
+   ASSERT_EQ(operands.intern(operand), id);
+   ASSERT_EQ(operands.size(), 1u);
+   ASSERT_EQ(operands.operand(id), operand);
+
+   operands.record_access(id, 1);
+   operands.record_access(id, 2);
+   operands.record_join(id);
+   ASSERT_EQ(operands.intern(operand), id);
+   ASSERT_EQ(operands.statistics(id).nr_accesses, 2u);
+   ASSERT_EQ(operands.statistics(id).threads, (tid_set{1, 2}));
+   ASSERT_EQ(operands.statistics(id).nr_joins, 1u);
+
+   std::ostringstream os;
+   operands.dump(os);
+   const std::string dump = os.str();
+   ASSERT_EQ(std::count(dump.begin(), dump.end(), '\n'), 1);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief The ids are shared by all explorations of a dpor, hence object_statistics.txt has
+/// exactly one line per operand, however often the operand is accessed.
+
+TEST(OperandInternerTest, ObjectStatisticsListsEveryOperandOnce)
+{
+   using dpor_t = Exploration<depth_first_search<dpor<Persistent>>>;
+   const auto output_dir = detail::test_data_dir / "forwarded_race.c" / "operands";
+   dpor_t dpor{detail::test_programs_dir / "forwarded_race.c", 4};
+   dpor.run({}, "0", "", output_dir);
+   ASSERT_EQ(dpor.statistics().nr_explorations(), 3u);
+
+   std::ifstream ifs((output_dir / "object_statistics.txt").string());
+   ASSERT_TRUE(ifs.good());
+   std::set<std::string> operands;
+   unsigned int nr_lines = 0;
+   unsigned int nr_joins = 0;
+   for (std::string line; std::getline(ifs, line); ++nr_lines)
+   {
+      // operand nr_accesses threads nr_joins
+      std::vector<std::string> columns;
+      std::istringstream is(line);
+      for (std::string column; std::getline(is, column, '\t');)
+         columns.push_back(column);
+      ASSERT_EQ(columns.size(), 4u) << line;
+      operands.insert(columns[0]);
+      EXPECT_GT(std::stoul(columns[1]), 0u) << line;
+      nr_joins += std::stoul(columns[3]);
+   }
+   EXPECT_GT(nr_lines, 0u);
+   EXPECT_EQ(operands.size(), nr_lines);
+   // The writes of a and b to x race
+   EXPECT_GT(nr_joins, 0u);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace test
+} // end namespace exploration
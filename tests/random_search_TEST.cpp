@@ -0,0 +1,118 @@
+
+#include <test_helpers.hpp>
+
+#include <exploration.hpp>
+#include <parallel_exploration.hpp>
+#include <random_search.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+
+namespace exploration {
+namespace test {
+
+//--------------------------------------------------------------------------------------------------
+
+struct RandomSearchTest
+   : public ::testing::TestWithParam<std::tuple<NrExecutionsTestData, random_search::strategy_t>>
+{
+   const NrExecutionsTestData& data() const { return std::get<0>(GetParam()); }
+   random_search::strategy_t strategy() const { return std::get<1>(GetParam()); }
+
+   boost::filesystem::path test_output_dir() const
+   {
+      return detail::test_data_dir / data().test_program.filename() /
+             boost::filesystem::path("0" + data().optimization_level) /
+             (strategy() == random_search::strategy_t::pct ? "pct" : "uniform");
+   }
+
+   /// @brief Returns the sum of the values of key in the given statistics file.
+   static unsigned int value_of(const boost::filesystem::path& file, const std::string& key)
+   {
+      unsigned int sum = 0;
+      std::ifstream ifs(file.string());
+      for (std::string line; std::getline(ifs, line);)
+      {
+         if (line.compare(0, key.size() + 1, key + "\t") == 0)
+            sum += std::stoul(line.substr(key.size() + 1));
+      }
+      return sum;
+   }
+}; // end struct RandomSearchTest
+
+
+TEST_P(RandomSearchTest, SameSeedSamplesSameSchedules)
+{
+   const auto program = detail::test_programs_dir / data().test_program;
+   const Settings settings{false, false, scheduler::timeout_t{200}};
+   const unsigned int depth = 3;
+   const unsigned int seed = 42;
+
+   Exploration<random_search> first(program, data().expected_nr_executions, strategy(), depth,
+                                    seed);
+   first.set_settings(settings);
+   first.run({}, data().optimization_level, data().compiler_options,
+             test_output_dir() / "first");
+
+   Exploration<random_search> second(program, data().expected_nr_executions, strategy(), depth,
+                                     seed);
+   second.set_settings(settings);
+   second.run({}, data().optimization_level, data().compiler_options,
+              test_output_dir() / "second");
+
+   EXPECT_EQ(first.statistics().nr_explorations(), data().expected_nr_executions);
+   EXPECT_EQ(first.mode().statistics().nr_distinct_schedules(),
+             second.mode().statistics().nr_distinct_schedules());
+   EXPECT_EQ(first.mode().statistics().nr_duplicate_schedules(),
+             second.mode().statistics().nr_duplicate_schedules());
+   // With uniform, every sample leaves the explored schedules at the end of its prefix
+   if (strategy() == random_search::strategy_t::uniform)
+   {
+      EXPECT_EQ(first.mode().statistics().nr_duplicate_schedules(), 0u);
+   }
+}
+
+
+TEST_P(RandomSearchTest, ParallelSamplesGivenNrOfExecutions)
+{
+   const auto program = detail::test_programs_dir / data().test_program;
+   const Settings settings{false, false, scheduler::timeout_t{200}};
+
+   const auto statistics = parallel::sample<random_search>(
+      3, program, data().expected_nr_executions, settings, data().optimization_level,
+      data().compiler_options, test_output_dir() / "parallel", 0, strategy(), 3u);
+
+   EXPECT_EQ(statistics.nr_explorations(), data().expected_nr_executions);
+
+   // The merged counts treat a schedule that several workers sampled as one distinct schedule
+   const auto dir = test_output_dir() / "parallel";
+   const auto nr_distinct = value_of(dir / "statistics.txt", "nr_distinct_schedules");
+   EXPECT_GT(nr_distinct, 0u);
+   EXPECT_EQ(nr_distinct + value_of(dir / "statistics.txt", "nr_duplicate_schedules"),
+             data().expected_nr_executions);
+   unsigned int nr_distinct_per_worker = 0;
+   for (unsigned int id = 0; id < 3; ++id)
+   {
+      const auto worker_nr_distinct = value_of(dir / ("worker_" + std::to_string(id)) /
+                                               "statistics.txt", "nr_distinct_schedules");
+      EXPECT_LE(worker_nr_distinct, nr_distinct);
+      nr_distinct_per_worker += worker_nr_distinct;
+   }
+   EXPECT_LE(nr_distinct, nr_distinct_per_worker);
+}
+
+
+INSTANTIATE_TEST_CASE_P(
+   RandomSearchTests, RandomSearchTest,
+   ::testing::Combine(::testing::Values(NrExecutionsTestData{"benchmarks/readers_nonpreemptive.c",
+                                                             "0", "", 50}),
+                      ::testing::Values(random_search::strategy_t::uniform,
+                                        random_search::strategy_t::pct)));
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace test
+} // end namespace exploration
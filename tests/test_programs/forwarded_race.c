@@ -0,0 +1,48 @@
+//--------------------------------------------------------------------------------------------------
+/// @file forwarded_race.c
+/// @brief Thread a writes x twice and thread b writes x once. The first execution adds b to the 
+/// states before both writes of a, so a split hands out the subtree in which b writes first. 
+/// There, the race of b's write with a's first write adds a to the state before b's write, i.e. 
+/// to a state that the worker exploring the subtree does not own, and the backtrack point is 
+/// forwarded.
+/// @date 2026
+//--------------------------------------------------------------------------------------------------
+
+#include <pthread.h>
+
+//--------------------------------------------------------------------------------------------------
+
+int x;
+
+//--------------------------------------------------------------------------------------------------
+
+void* a(void* arg)
+{
+   x = 1;
+   x = 2;
+   pthread_exit(0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void* b(void* arg)
+{
+   x = 3;
+   pthread_exit(0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int main()
+{
+   pthread_t thread_a;
+   pthread_t thread_b;
+   
+   pthread_create(&thread_a, NULL, a, NULL);
+   pthread_create(&thread_b, NULL, b, NULL);
+   
+   pthread_join(thread_a, NULL);
+   pthread_join(thread_b, NULL);
+   
+   return 0;
+}
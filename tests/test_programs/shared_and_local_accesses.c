@@ -0,0 +1,60 @@
+//--------------------------------------------------------------------------------------------------
+/// @file shared_and_local_accesses.c
+/// @brief Every worker updates an object of its own, reads an object that the others read too 
+/// and updates an object under a lock, such that the executions mix thread-local accesses, runs 
+/// of independent steps, shared reads, writes and locks.
+/// @date 2026
+//--------------------------------------------------------------------------------------------------
+
+#include <pthread.h>
+
+#ifndef NR_THREADS
+#define NR_THREADS 3
+#endif
+
+//--------------------------------------------------------------------------------------------------
+
+int x;
+int y;
+int z[NR_THREADS];
+pthread_mutex_t m;
+
+//--------------------------------------------------------------------------------------------------
+
+void* worker(void* arg)
+{
+   int id = *(int*)arg;
+   z[id] = id;
+   z[id] = z[id] + x;
+   pthread_mutex_lock(&m);
+   y = y + z[id];
+   pthread_mutex_unlock(&m);
+   if (id == 0)
+   {
+      x = 1;
+   }
+   pthread_exit(0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int main()
+{
+   pthread_t threads[NR_THREADS];
+   int tids[NR_THREADS];
+   
+   pthread_mutex_init(&m, NULL);
+   
+   for (int i = 0; i < NR_THREADS; ++i)
+   {
+      tids[i] = i;
+      pthread_create(threads + i, NULL, worker, tids + i);
+   }
+   
+   for (int i = 0; i < NR_THREADS; ++i)
+   {
+      pthread_join(threads[i], NULL);
+   }
+   
+   return 0;
+}
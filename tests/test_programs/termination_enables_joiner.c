@@ -0,0 +1,50 @@
+//--------------------------------------------------------------------------------------------------
+/// @file termination_enables_joiner.c
+/// @brief The termination of thread a enables the main thread, which reads x, while the write of 
+/// thread b to x is in the sleepset. Scheduling a first is therefore not sleepset blocked, 
+/// although a only takes a step that is independent of every other thread.
+/// @date 2026
+//--------------------------------------------------------------------------------------------------
+
+#include <pthread.h>
+
+//--------------------------------------------------------------------------------------------------
+
+int x;
+int y;
+
+//--------------------------------------------------------------------------------------------------
+
+void* a(void* arg)
+{
+   y = 1;
+   pthread_exit(0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void* b(void* arg)
+{
+   x = 1;
+   pthread_exit(0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+int main()
+{
+   pthread_t thread_a;
+   pthread_t thread_b;
+   
+   x = 0;
+   y = 0;
+   
+   pthread_create(&thread_a, NULL, a, NULL);
+   pthread_create(&thread_b, NULL, b, NULL);
+   
+   pthread_join(thread_a, NULL);
+   int local = x;
+   pthread_join(thread_b, NULL);
+   
+   return 0;
+}
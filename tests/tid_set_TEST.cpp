@@ -0,0 +1,86 @@
+
+#include <tid_set.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+
+namespace exploration {
+namespace test {
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(TidSetTest, IteratesInIncreasingOrder)
+{
+   const tid_set tids{130, 3, 64, 0, 63};
+
+   const std::vector<int> values(tids.begin(), tids.end());
+   ASSERT_EQ(values, (std::vector<int>{0, 3, 63, 64, 130}));
+   ASSERT_EQ(tids.size(), 5);
+   ASSERT_EQ(tids.count(64), 1);
+   ASSERT_EQ(tids.count(65), 0);
+   ASSERT_EQ(tids.count(1000), 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(TidSetTest, EqualityIgnoresEmptySpilledWords)
+{
+   tid_set tids{1, 200};
+   tids.erase(200);
+
+   ASSERT_EQ(tids, tid_set{1});
+   ASSERT_FALSE(tids.empty());
+   tids.erase(1);
+   ASSERT_TRUE(tids.empty());
+   ASSERT_EQ(tids.begin(), tids.end());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Checks union, intersection and difference of random tid_sets against the corresponding
+/// std::set algorithms on program_model::Tids.
+
+struct TidSetOperationsTest : public ::testing::TestWithParam<int>
+{
+};
+
+TEST_P(TidSetOperationsTest, AsStdSetOperations)
+{
+   std::mt19937 generator(GetParam());
+   std::uniform_int_distribution<int> random_tid(0, GetParam() - 1);
+   for (unsigned int run = 0; run < 50; ++run)
+   {
+      program_model::Tids lhs, rhs;
+      for (int i = 0; i < GetParam() / 2; ++i)
+      {
+         lhs.insert(random_tid(generator));
+         rhs.insert(random_tid(generator));
+      }
+      program_model::Tids expected_union, expected_intersection, expected_difference;
+      std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                     std::inserter(expected_union, expected_union.end()));
+      std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                            std::inserter(expected_intersection, expected_intersection.end()));
+      std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                          std::inserter(expected_difference, expected_difference.end()));
+
+      ASSERT_EQ((tid_set(lhs) | tid_set(rhs)).to_tids(), expected_union);
+      ASSERT_EQ((tid_set(lhs) & tid_set(rhs)).to_tids(), expected_intersection);
+      ASSERT_EQ((tid_set(lhs) - tid_set(rhs)).to_tids(), expected_difference);
+      ASSERT_EQ(tid_set(lhs).size(), lhs.size());
+   }
+}
+
+INSTANTIATE_TEST_CASE_P(TidSetOperationsTests, TidSetOperationsTest,
+                        ::testing::Values(1, 8, 64, 65, 200));
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace test
+} // end namespace exploration
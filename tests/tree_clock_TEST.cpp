@@ -0,0 +1,71 @@
+
+#include <tree_clock.hpp>
+#include <vector_clock.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+
+namespace exploration {
+namespace test {
+
+//--------------------------------------------------------------------------------------------------
+
+/// @brief Simulates executions of a random program with nr_threads threads in which every
+/// Transition joins the clocks of the last Transitions of some other threads, and checks that
+/// tree_clock joins yield the same clocks as VectorClock joins.
+
+struct TreeClockJoinTest : public ::testing::TestWithParam<unsigned int>
+{
+};
+
+TEST_P(TreeClockJoinTest, ValuesAreAsVectorClockJoin)
+{
+   const unsigned int nr_threads = 12;
+   const unsigned int nr_transitions = 500;
+   std::mt19937 generator(GetParam());
+   std::uniform_int_distribution<int> random_tid(0, nr_threads - 1);
+   std::uniform_int_distribution<int> random_nr_joins(0, 3);
+
+   std::vector<VectorClock> vector_clocks;
+   std::vector<tree_clock> tree_clocks;
+   for (unsigned int tid = 0; tid < nr_threads; ++tid)
+   {
+      vector_clocks.emplace_back(nr_threads);
+      tree_clocks.emplace_back(VectorClock(nr_threads), tid);
+   }
+
+   for (unsigned int index = 1; index <= nr_transitions; ++index)
+   {
+      const auto tid = random_tid(generator);
+      VectorClock vector_clock = vector_clocks[tid];
+      tree_clock tree = tree_clocks[tid];
+      vector_clock[tid] = index;
+      tree.advance(index);
+      for (auto nr_joins = random_nr_joins(generator); nr_joins > 0; --nr_joins)
+      {
+         const auto other = random_tid(generator);
+         vector_clock.max(vector_clocks[other]);
+         if (nr_joins % 2 == 0)
+            tree.join(tree_clocks[other]);
+         else
+            tree.join(static_cast<clock_view>(vector_clocks[other]));
+      }
+      vector_clocks[tid] = vector_clock;
+      // Now and then, rebuild the clock as is done when popping a Transition
+      tree_clocks[tid] = index % 7 == 0 ? tree_clock(vector_clock, tid) : tree;
+      for (unsigned int tid_ = 0; tid_ < nr_threads; ++tid_)
+      {
+         ASSERT_EQ(tree[tid_], vector_clock[tid_]);
+      }
+   }
+}
+
+INSTANTIATE_TEST_CASE_P(TreeClockJoinTests, TreeClockJoinTest, ::testing::Values(1, 2, 3, 4, 5));
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace test
+} // end namespace exploration
@@ -1,8 +1,14 @@
 
+#include <clock_arena.hpp>
 #include <vector_clock.hpp>
+#include <vector_clock_kernels.hpp>
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <random>
+#include <vector>
+
 
 namespace exploration {
 namespace test {
@@ -59,5 +65,113 @@ TEST(VectorClockCopyFromMatchingOtherTest, CopyIsEqual)
    ASSERT_EQ(clock[2], 3);
 }
 
+//--------------------------------------------------------------------------------------------------
+
+TEST(ClockArenaSetWidthTest, RowsAreCopiesFilledWithZeros)
+{
+   auto clock = VectorClock{2};
+   clock[0] = 1;
+   clock[1] = 2;
+
+   auto arena = clock_arena{2, 1};
+   arena.push_back(clock);
+   arena.set_width(3);
+
+   ASSERT_EQ(arena.size(), 2);
+   ASSERT_EQ(arena[0][0], 0);
+   ASSERT_EQ(arena[1][0], 1);
+   ASSERT_EQ(arena[1][1], 2);
+   ASSERT_EQ(arena[1][2], 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(ClockArenaTest, RowsAreAlignedAndPadded)
+{
+   auto clock = VectorClock{3};
+   clock[0] = 1;
+   clock[1] = 2;
+   clock[2] = 3;
+
+   auto arena = clock_arena{3, 1};
+   arena.push_back(clock, 1, 5);
+   arena.set_width(9);
+   arena.push_back(VectorClock{arena[1], 9});
+
+   ASSERT_EQ(arena.size(), 3);
+   for (std::size_t row = 0; row < arena.size(); ++row)
+   {
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(arena[row].cbegin()) % kernels::alignment, 0);
+   }
+   ASSERT_EQ(arena[2][0], 1);
+   ASSERT_EQ(arena[2][1], 5);
+   ASSERT_EQ(arena[2][2], 3);
+   ASSERT_EQ(arena[2][8], 0);
+}
+
+//--------------------------------------------------------------------------------------------------
+
+struct VectorClockKernelsTest
+   : public ::testing::TestWithParam<std::tuple<kernels::instruction_set, std::size_t>>
+{
+   void SetUp() override
+   {
+      std::mt19937 generator(std::get<1>(GetParam()));
+      std::uniform_int_distribution<kernels::value_t> distribution(0, 64);
+      for (std::size_t i = 0; i < std::get<1>(GetParam()); ++i)
+      {
+         lhs.push_back(distribution(generator));
+         rhs.push_back(distribution(generator));
+      }
+   }
+
+   bool supported() const { return kernels::supported(std::get<0>(GetParam())); }
+   const kernels::kernels_t& scalar() const
+   {
+      return kernels::get(kernels::instruction_set::scalar);
+   }
+   const kernels::kernels_t& simd() const { return kernels::get(std::get<0>(GetParam())); }
+
+   std::vector<kernels::value_t> lhs;
+   std::vector<kernels::value_t> rhs;
+};
+
+TEST_P(VectorClockKernelsTest, MaxIsAsScalar)
+{
+   if (!supported())
+      return;
+   auto expected = lhs;
+   scalar().max(expected.data(), rhs.data(), lhs.size());
+   simd().max(lhs.data(), rhs.data(), lhs.size());
+   ASSERT_EQ(lhs, expected);
+}
+
+TEST_P(VectorClockKernelsTest, FilterValuesGreaterThanIsAsScalar)
+{
+   if (!supported())
+      return;
+   auto expected = lhs;
+   scalar().filter_values_greater_than(expected.data(), rhs.data(), lhs.size());
+   simd().filter_values_greater_than(lhs.data(), rhs.data(), lhs.size());
+   ASSERT_EQ(lhs, expected);
+}
+
+TEST_P(VectorClockKernelsTest, MinAndMaxElementAreAsScalar)
+{
+   if (!supported())
+      return;
+   ASSERT_EQ(simd().min_element(lhs.data(), lhs.size()),
+             scalar().min_element(lhs.data(), lhs.size()));
+   ASSERT_EQ(simd().max_element(lhs.data(), lhs.size()),
+             scalar().max_element(lhs.data(), lhs.size()));
+}
+
+INSTANTIATE_TEST_CASE_P(VectorClockKernelsTests, VectorClockKernelsTest,
+                        ::testing::Combine(::testing::Values(kernels::instruction_set::sse4_1,
+                                                             kernels::instruction_set::avx2),
+                                           ::testing::Values(1, 3, 4, 7, 8, 12, 13, 32, 131)));
+
+//--------------------------------------------------------------------------------------------------
+
 } // end namespace test
 } // end namespace exploration
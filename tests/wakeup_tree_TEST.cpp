@@ -0,0 +1,94 @@
+
+#include <wakeup_tree.hpp>
+
+#include <gtest/gtest.h>
+
+
+namespace exploration {
+namespace test {
+
+//--------------------------------------------------------------------------------------------------
+
+namespace {
+
+transition_record load(const program_model::Thread::tid_t tid, const operand_interner::id_t operand)
+{
+   return {tid, operation_kind::load, operand};
+}
+
+transition_record store(const program_model::Thread::tid_t tid, const operand_interner::id_t operand)
+{
+   return {tid, operation_kind::store, operand};
+}
+
+} // end namespace
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(WakeupTreeTest, WeakInitials)
+{
+   const wakeup_tree::sequence_t sequence{store(1, 0), load(2, 0), load(3, 1)};
+
+   ASSERT_TRUE(weak_initial(store(1, 0), sequence));
+   ASSERT_FALSE(weak_initial(load(2, 0), sequence));
+   ASSERT_TRUE(weak_initial(load(3, 1), sequence));
+   // Thread 4 does not occur in sequence
+   ASSERT_TRUE(weak_initial(load(4, 1), sequence));
+   ASSERT_FALSE(weak_initial(load(4, 0), sequence));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(WakeupTreeTest, InsertAddsUncoveredSequencesAsRightmostBranch)
+{
+   wakeup_tree tree;
+   tree.add_leaf(store(1, 0));
+
+   ASSERT_TRUE(tree.insert({load(3, 1), load(2, 0)}));
+   ASSERT_EQ(tree.children(), (tid_set{1, 3}));
+   ASSERT_EQ(tree.first(), 1);
+   const auto branch = tree.branch(3);
+   ASSERT_EQ(branch.size(), 2);
+   ASSERT_EQ(branch[1].tid, 2);
+   ASSERT_EQ(tree.subtree(3).first(), 2);
+   ASSERT_TRUE(tree.subtree(1).empty());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(WakeupTreeTest, InsertSkipsCoveredSequences)
+{
+   wakeup_tree tree;
+   tree.insert({load(3, 1), load(2, 0)});
+
+   // 1's store to operand 1 is a weak initial of the sequence, but 1 is a leaf
+   tree.add_leaf(store(1, 1));
+   ASSERT_FALSE(tree.insert({load(2, 2), store(1, 1)}));
+   // 3 is a weak initial by independence and the remainder is covered by the branch below 3
+   ASSERT_FALSE(tree.insert({load(2, 0)}));
+   ASSERT_EQ(tree.children(), (tid_set{1, 3}));
+
+   // the remainder after 3 is not covered below 3
+   ASSERT_TRUE(tree.insert({load(3, 1), store(4, 0)}));
+   ASSERT_EQ(tree.subtree(3).children(), (tid_set{2, 4}));
+}
+
+//--------------------------------------------------------------------------------------------------
+
+TEST(WakeupTreeTest, RemoveDropsSubtree)
+{
+   wakeup_tree tree;
+   tree.insert({load(3, 1), load(2, 0)});
+   tree.add_leaf(store(1, 0));
+   tree.remove(3);
+
+   ASSERT_EQ(tree.first(), 1);
+   ASSERT_FALSE(tree.contains(3));
+   tree.remove(1);
+   ASSERT_TRUE(tree.empty());
+}
+
+//--------------------------------------------------------------------------------------------------
+
+} // end namespace test
+} // end namespace exploration